@@ -0,0 +1,220 @@
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "circuit.h"
+#include "euler_trail_solver.h"
+#include "ordering.h"
+#include "parse.h"
+#include "path.h"
+#include "path_finder.h"
+
+using namespace euler;
+
+namespace euler {
+
+/// @brief Runs the phases of the path finder one by one, timing each of them.
+/// @note Only the deterministic heuristic is run, which is what the phases
+/// are made of; the exact solver and the local search are left out. The Euler
+/// trails are run on the same pairs to compare with.
+class PathFinderBenchmark {
+ public:
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  struct Result {
+    std::size_t number_of_pairs = 0;
+    Milliseconds group_vertices{};
+    Milliseconds build_graph{};
+    Milliseconds find_hamilton_paths{};
+    Milliseconds calculate_hpwl{};
+    std::size_t number_of_dummies = 0;
+    double hpwl = 0.0;
+    Milliseconds find_euler_trails{};
+    std::size_t number_of_euler_trail_dummies = 0;
+    double euler_trail_hpwl = 0.0;
+  };
+
+  static Result Run(const Circuit& circuit) {
+    auto result = Result{};
+    auto path_finder = PathFinder{circuit};
+    result.group_vertices = Time_([&]() { path_finder.GroupVertices_(); });
+    result.number_of_pairs = path_finder.vertices_.size();
+    result.build_graph = Time_([&]() { path_finder.BuildGraph_(); });
+
+    const auto sorted_vertices = path_finder.SortedVertices_();
+    auto paths = std::vector<Path>{};
+    result.find_hamilton_paths = Time_([&]() {
+      paths = path_finder.FindHamiltonPaths_(path_finder.adjacency_list_,
+                                             sorted_vertices);
+    });
+    // Each connection between two paths takes a pair of dummies.
+    result.number_of_dummies = 2 * (paths.size() - 1);
+    const auto path = path_finder.ConnectWithDummies_(paths);
+    result.calculate_hpwl
+        = Time_([&]() { result.hpwl = path_finder.CalculateHpwl_(path); });
+
+    auto euler_trails = std::vector<Path>{};
+    result.find_euler_trails = Time_([&]() {
+      euler_trails
+          = ToPaths(EulerTrailSolver{path_finder.vertices_}.Solve());
+    });
+    result.number_of_euler_trail_dummies = 2 * (euler_trails.size() - 1);
+    result.euler_trail_hpwl = path_finder.CalculateHpwl_(
+        path_finder.ConnectWithDummies_(euler_trails));
+    return result;
+  }
+
+ private:
+  template <typename F>
+  static Milliseconds Time_(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::steady_clock::now() - start;
+  }
+};
+
+}  // namespace euler
+
+namespace {
+
+void Usage(const char* prog_name) {
+  // clang-format off
+  std::cerr << "Usage: " << prog_name << " [-h] [-n N] IN\n";
+  std::cerr << '\n';
+  std::cerr << "    Times the phases of the path finder on IN and reports them as JSON.\n";
+  std::cerr << '\n';
+  std::cerr << "Options:\n";
+  std::cerr << "    -n N      Repeats N times and reports the fastest of each phase\n";
+  std::cerr << "              (default: 1)\n";
+  std::cerr << "    -h        Prints this help message\n";
+  // clang-format on
+}
+
+std::string Quote(const std::string& s) {
+  auto quoted = std::string{'"'};
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      quoted.push_back('\\');
+    }
+    quoted.push_back(c);
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+/// @return In kibibytes.
+long PeakRss() {
+  auto usage = rusage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto number_of_repeats = 1;
+  int c;
+  while ((c = getopt(argc, argv, "n:h")) != -1) {
+    switch (c) {
+      case 'n':
+        number_of_repeats = std::max(1, std::atoi(optarg));
+        break;
+      case 'h':
+        Usage(argv[0]);
+        return EXIT_SUCCESS;
+      default:
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (optind + 1 != argc) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  const auto in_file = std::string{argv[optind]};
+
+  auto parse = PathFinderBenchmark::Milliseconds::max();
+  auto circuits = std::vector<Circuit>{};
+  for (auto i = 0; i < number_of_repeats; i++) {
+    auto in = std::ifstream{in_file};
+    if (!in) {
+      std::perror(in_file.c_str());
+      return EXIT_FAILURE;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto parsed = Parse(in);
+    parse = std::min<PathFinderBenchmark::Milliseconds>(
+        parse, std::chrono::steady_clock::now() - start);
+    if (!parsed) {
+      return EXIT_FAILURE;
+    }
+    circuits = std::move(*parsed);
+  }
+  // The same netlist through the memory-mapped front end, to compare with.
+  auto parse_mapped = PathFinderBenchmark::Milliseconds::max();
+  for (auto i = 0; i < number_of_repeats; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto parsed = ParseMapped(in_file);
+    parse_mapped = std::min<PathFinderBenchmark::Milliseconds>(
+        parse_mapped, std::chrono::steady_clock::now() - start);
+    if (!parsed) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "{\n";
+  std::cout << "  \"netlist\": " << Quote(in_file) << ",\n";
+  std::cout << "  \"parse_ms\": " << parse.count() << ",\n";
+  std::cout << "  \"parse_mapped_ms\": " << parse_mapped.count() << ",\n";
+  std::cout << "  \"cells\": [";
+  for (auto i = std::size_t{0}; i < circuits.size(); i++) {
+    const auto& circuit = circuits.at(i);
+    auto best = PathFinderBenchmark::Run(circuit);
+    for (auto j = 1; j < number_of_repeats; j++) {
+      auto result = PathFinderBenchmark::Run(circuit);
+      best.group_vertices
+          = std::min(best.group_vertices, result.group_vertices);
+      best.build_graph = std::min(best.build_graph, result.build_graph);
+      best.find_hamilton_paths
+          = std::min(best.find_hamilton_paths, result.find_hamilton_paths);
+      best.calculate_hpwl
+          = std::min(best.calculate_hpwl, result.calculate_hpwl);
+      best.find_euler_trails
+          = std::min(best.find_euler_trails, result.find_euler_trails);
+    }
+    std::cout << (i ? "," : "") << "\n    {\n";
+    std::cout << "      \"name\": " << Quote(circuit.name) << ",\n";
+    std::cout << "      \"mos\": " << circuit.mos.size() << ",\n";
+    std::cout << "      \"pairs\": " << best.number_of_pairs << ",\n";
+    std::cout << "      \"group_vertices_ms\": " << best.group_vertices.count()
+              << ",\n";
+    std::cout << "      \"build_graph_ms\": " << best.build_graph.count()
+              << ",\n";
+    std::cout << "      \"find_hamilton_paths_ms\": "
+              << best.find_hamilton_paths.count() << ",\n";
+    std::cout << "      \"calculate_hpwl_ms\": " << best.calculate_hpwl.count()
+              << ",\n";
+    std::cout << "      \"dummies\": " << best.number_of_dummies << ",\n";
+    std::cout << "      \"hpwl\": " << best.hpwl << ",\n";
+    std::cout << "      \"find_euler_trails_ms\": "
+              << best.find_euler_trails.count() << ",\n";
+    std::cout << "      \"euler_trail_dummies\": "
+              << best.number_of_euler_trail_dummies << ",\n";
+    std::cout << "      \"euler_trail_hpwl\": " << best.euler_trail_hpwl
+              << "\n";
+    std::cout << "    }";
+  }
+  std::cout << "\n  ],\n";
+  std::cout << "  \"peak_rss_kib\": " << PeakRss() << "\n";
+  std::cout << "}" << std::endl;
+  return EXIT_SUCCESS;
+}
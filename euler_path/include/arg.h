@@ -10,37 +10,184 @@
 namespace euler {
 
 constexpr int kNumberOfArguments = 2;
+/// @note Keep in sync with `ExactSolver::kMaxNumberOfVertices`.
+constexpr unsigned kMaxExactLimit = 20;
 
 struct Argument {
   std::string in;
   std::string out;
+  /// @brief Cells with no more P/N pairs than this are solved exactly.
+  unsigned exact_limit = 16;
+  /// @brief Solves the larger cells with Euler trails instead of Hamiltonian
+  /// paths.
+  bool euler_trail = false;
+  /// @brief The number of randomized starts. 0 means unbounded, which
+  /// requires a time budget.
+  unsigned starts = 1;
+  /// @brief In milliseconds. 0 means unbounded.
+  unsigned time_budget = 0;
+  /// @brief 0 means to use all the hardware threads.
+  unsigned threads = 0;
+  unsigned seed = 0;
+  /// @brief 0 disables the local search.
+  unsigned local_search_moves = 1U << 18;
+  /// @brief In milliseconds. 0 means unbounded.
+  unsigned local_search_budget = 0;
+  /// @brief The maximum number of successive rotations tried on a path that
+  /// can no longer be extended.
+  unsigned rotation_depth = 2;
+  /// @brief The time limit of each cell, in milliseconds. 0 means unbounded.
+  unsigned time_limit = 0;
+  /// @brief Writes each cell into its own file under the directory `out`.
+  bool per_cell = false;
+  /// @brief The file to load and save the cached orderings. Empty means the
+  /// cache is kept in memory only.
+  std::string cache;
+  /// @brief Reports the counters and the timers of each cell to the standard
+  /// error as JSON.
+  bool stats = false;
+  /// @brief Parses the input by memory-mapping it, with the hand-written
+  /// front end.
+  bool mmap = false;
 };
 
 inline void Usage(const char* prog_name) {
   // clang-format off
-  std::cerr << "Usage: " << prog_name << " IN OUT\n";
+  std::cerr << "Usage: " << prog_name << " [-h] [-e N] [-E ENGINE] [-s N] [-b MS] [-j N] [-r SEED] [-L N] [-l MS] [-d N] [-t MS] [-p] [-c FILE] [-S] [-m] IN OUT\n";
   std::cerr << '\n';
   std::cerr << "Options:\n";
-  std::cerr << "    -h, --help       Prints this help message\n";
+  std::cerr << "    -e, --exact-limit N   Solves cells with at most N P/N pairs exactly\n";
+  std::cerr << "                          (default: 16, at most 20; 0 always uses the heuristic).\n";
+  std::cerr << "                          Each cell solved exactly takes 2^N * 4N bytes, 80 MiB\n";
+  std::cerr << "                          at N = 20, on each thread running the cells\n";
+  std::cerr << "    -E, --engine ENGINE   Solves the larger cells with hamilton (default), the\n";
+  std::cerr << "                          Hamiltonian path heuristic, or euler, the Euler trails\n";
+  std::cerr << "                          on the diffusion graph, which is linear but a greedy\n";
+  std::cerr << "                          approximation with more dummies\n";
+  std::cerr << "    -s, --starts N        Runs N randomized searches and keeps the best path\n";
+  std::cerr << "                          (default: 1; 0 runs until the time budget is used up)\n";
+  std::cerr << "    -b, --time-budget MS  Launches no more searches after MS milliseconds\n";
+  std::cerr << "    -j, --threads N       Runs the searches, or the cells of a library, on N threads\n";
+  std::cerr << "                          (default: the number of hardware threads)\n";
+  std::cerr << "    -r, --seed SEED       Seeds the randomized searches (default: 0)\n";
+  std::cerr << "    -L, --local-search-moves N Improves the HPWL of the path with at most N moves\n";
+  std::cerr << "                          (default: 262144; 0 disables the local search)\n";
+  std::cerr << "    -l, --local-search MS Also stops the local search after MS milliseconds, which\n";
+  std::cerr << "                          makes the path vary from run to run (default: unbounded)\n";
+  std::cerr << "    -d, --rotation-depth N Rotates a path that can't be extended up to N times in a\n";
+  std::cerr << "                          row to look for an extension (default: 2; 0 disables it)\n";
+  std::cerr << "    -t, --time-limit MS   Stops the search of each cell after MS milliseconds and\n";
+  std::cerr << "                          chains the rest of the pairs with the Euler trails\n";
+  std::cerr << "    -p, --per-cell        Writes each cell of the library to OUT/NAME.out\n";
+  std::cerr << "    -c, --cache FILE      Reuses the paths of the cells of the same topology\n";
+  std::cerr << "                          across runs through FILE\n";
+  std::cerr << "    -S, --stats           Reports the search counters and the time of each phase\n";
+  std::cerr << "                          to the standard error as JSON\n";
+  std::cerr << "    -m, --mmap            Parses IN by memory-mapping it, which is faster on large\n";
+  std::cerr << "                          flattened netlists\n";
+  std::cerr << "    -h, --help            Prints this help message\n";
   std::cerr << '\n';
   std::cerr << "Arguments:\n";
-  std::cerr << "    IN               The netlist to find euler path on\n";
-  std::cerr << "    OUT              The file to write the path result to\n";
+  std::cerr << "    IN                    The netlist, or library of netlists, to find euler path on\n";
+  std::cerr << "    OUT                   The file (or directory with -p) to write the path result to\n";
   // clang-format on
 }
 
 inline struct option long_options[] = {
+    {"exact-limit", required_argument, 0, 'e'},
+    {"engine", required_argument, 0, 'E'},
+    {"starts", required_argument, 0, 's'},
+    {"time-budget", required_argument, 0, 'b'},
+    {"threads", required_argument, 0, 'j'},
+    {"seed", required_argument, 0, 'r'},
+    {"local-search-moves", required_argument, 0, 'L'},
+    {"local-search", required_argument, 0, 'l'},
+    {"rotation-depth", required_argument, 0, 'd'},
+    {"time-limit", required_argument, 0, 't'},
+    {"per-cell", no_argument, 0, 'p'},
+    {"cache", required_argument, 0, 'c'},
+    {"stats", no_argument, 0, 'S'},
+    {"mmap", no_argument, 0, 'm'},
     {"help", no_argument, 0, 'h'},
     {0, 0, 0, 0},
 };
 
+/// @note Exits with failure if `value` is not a non-negative integer.
+inline unsigned ParseUnsigned(const char* prog_name, const char* value) {
+  char* end = nullptr;
+  auto number = std::strtoul(value, &end, 10);
+  if (*value == '\0' || *value == '-' || *end != '\0') {
+    std::cerr << prog_name << ": invalid number -- " << value << '\n';
+    Usage(prog_name);
+    std::exit(EXIT_FAILURE);
+  }
+  return static_cast<unsigned>(number);
+}
+
 inline Argument HandleArguments(int argc, char** argv) {
   auto arg = Argument{};
 
   // Handle options
   int c;
-  while ((c = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+  while ((c = getopt_long(argc, argv, "e:E:s:b:j:r:L:l:d:t:pc:Smh", long_options, nullptr))
+         != -1) {
     switch (c) {
+      case 'e':
+        arg.exact_limit = ParseUnsigned(argv[0], optarg);
+        if (arg.exact_limit > kMaxExactLimit) {
+          std::cerr << argv[0] << ": the exact limit is at most "
+                    << kMaxExactLimit << '\n';
+          Usage(argv[0]);
+          std::exit(EXIT_FAILURE);
+        }
+        break;
+      case 'E':
+        if (optarg == std::string{"hamilton"}) {
+          arg.euler_trail = false;
+        } else if (optarg == std::string{"euler"}) {
+          arg.euler_trail = true;
+        } else {
+          std::cerr << argv[0] << ": unknown engine -- " << optarg << '\n';
+          Usage(argv[0]);
+          std::exit(EXIT_FAILURE);
+        }
+        break;
+      case 's':
+        arg.starts = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'b':
+        arg.time_budget = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'j':
+        arg.threads = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'r':
+        arg.seed = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'L':
+        arg.local_search_moves = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'l':
+        arg.local_search_budget = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'd':
+        arg.rotation_depth = ParseUnsigned(argv[0], optarg);
+        break;
+      case 't':
+        arg.time_limit = ParseUnsigned(argv[0], optarg);
+        break;
+      case 'p':
+        arg.per_cell = true;
+        break;
+      case 'c':
+        arg.cache = optarg;
+        break;
+      case 'S':
+        arg.stats = true;
+        break;
+      case 'm':
+        arg.mmap = true;
+        break;
       case 'h':
         Usage(argv[0]);
         std::exit(EXIT_SUCCESS);
@@ -69,6 +216,12 @@ inline Argument HandleArguments(int argc, char** argv) {
     std::exit(EXIT_FAILURE);
   }
 
+  if (arg.starts == 0 && arg.time_budget == 0) {
+    std::cerr << argv[0] << ": unbounded starts require a time budget\n";
+    Usage(argv[0]);
+    std::exit(EXIT_FAILURE);
+  }
+
   return arg;
 }
 
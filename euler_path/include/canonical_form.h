@@ -0,0 +1,39 @@
+#ifndef EULER_PATH_CANONICAL_FORM_H_
+#define EULER_PATH_CANONICAL_FORM_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace euler {
+
+class Mos;
+class Net;
+struct Circuit;
+
+/// @brief The topology of a circuit labelled canonically, with the names and
+/// the sizes of the MOS left out.
+/// @details The circuit is seen as a bipartite graph of the MOS and the nets,
+/// of which the edges are the gate, the diffusion (the drain and the source,
+/// which are interchangeable in the layout) and the substrate connections. The
+/// colors of the vertices are refined with the Weisfeiler-Lehman algorithm.
+/// The ties are then broken by individualizing each vertex of the first
+/// non-singleton color and refining again, and the labelling of the smallest
+/// certificate is taken.
+struct CanonicalForm {
+  /// @brief Encodes the whole graph under the labelling, so two circuits with
+  /// the same certificate are always isomorphic.
+  /// @note If the search on the ties is cut short, two isomorphic circuits may
+  /// have different certificates.
+  std::string certificate;
+  /// @brief The MOS in the canonical order.
+  std::vector<std::shared_ptr<Mos>> mos;
+  /// @brief The nets in the canonical order.
+  std::vector<std::shared_ptr<Net>> nets;
+};
+
+CanonicalForm CanonicalFormOf(const Circuit& circuit);
+
+}  // namespace euler
+
+#endif  // EULER_PATH_CANONICAL_FORM_H_
@@ -4,38 +4,58 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "symbol.h"
+
 namespace euler {
 class Mos;
 
 /// @brief Connects the MOS transistors.
 class Net {
  public:
-  Net(std::string name) : name_{std::move(name)} {}
+  explicit Net(Symbol name) : name_{name} {}
+  /// @brief Creates a dummy net, which is named "Dummy" and connects a pair
+  /// of dummies.
+  static std::shared_ptr<Net> CreateDummy();
+
+  std::string_view GetName() const {
+    return SymbolTable::Instance().NameOf(name_);
+  }
 
-  std::string GetName() const {
+  Symbol GetSymbol() const {
     return name_;
   }
 
+  bool IsDummy() const {
+    return is_dummy_;
+  }
+
+  /// @note The pins of a MOS are to be added one after another, which is how
+  /// the duplicates are told.
   void AddConnection(std::weak_ptr<Mos> mos);
   const std::vector<std::weak_ptr<Mos>>& Connections() const {
     return mos_;
   }
 
  private:
-  std::string name_;
+  Symbol name_;
+  bool is_dummy_ = false;
   std::vector<std::weak_ptr<Mos>> mos_{};
 };
 
 struct Circuit {
+  /// @brief The name of the subcircuit.
+  std::string name;
   std::vector<std::shared_ptr<Mos>> mos;
-  std::map<std::string, std::shared_ptr<Net>> nets;
+  /// @note Keyed by the names interned in the `SymbolTable`.
+  std::map<std::string_view, std::shared_ptr<Net>> nets;
 
-  Circuit(std::vector<std::shared_ptr<Mos>> mos,
-          std::map<std::string, std::shared_ptr<Net>> nets)
-      : mos{std::move(mos)}, nets{std::move(nets)} {}
+  Circuit(std::string name, std::vector<std::shared_ptr<Mos>> mos,
+          std::map<std::string_view, std::shared_ptr<Net>> nets)
+      : name{std::move(name)}, mos{std::move(mos)}, nets{std::move(nets)} {}
 };
 
 }  // namespace euler
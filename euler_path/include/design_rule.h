@@ -0,0 +1,16 @@
+#ifndef EULER_PATH_DESIGN_RULE_H_
+#define EULER_PATH_DESIGN_RULE_H_
+
+namespace euler {
+
+// Design rule parameters used in the HPWL calculation.
+
+constexpr auto kVerticalWidthIncrement = 27.0;
+constexpr auto kHorizontalExtension = 25.0;
+constexpr auto kGateSpacing = 34.0;
+constexpr auto kHorizontalGateWidth = 20.0;
+constexpr auto kUnitHorizontalWidth = kGateSpacing + kHorizontalGateWidth;
+
+}  // namespace euler
+
+#endif  // EULER_PATH_DESIGN_RULE_H_
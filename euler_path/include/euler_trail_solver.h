@@ -0,0 +1,55 @@
+#ifndef EULER_PATH_EULER_TRAIL_SOLVER_H_
+#define EULER_PATH_EULER_TRAIL_SOLVER_H_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "ordering.h"
+#include "path_finder.h"
+
+namespace euler {
+
+/// @brief Finds the ordering as Euler trails on the diffusion graph, in time
+/// linear to the number of vertices.
+/// @details The vertices of the diffusion graph are the (P net, N net) pairs,
+/// and each P/N pair of MOS is an edge between the nets on its two sides, so
+/// a trail is an ordering in which every P MOS and every N MOS shares the
+/// diffusion with the next. Of the two ways to connect a pair (flipping the P
+/// MOS and the N MOS together or apart), the one that leaves fewer vertices of
+/// odd degree is taken. In each connected component, all but two of the odd
+/// vertices are then paired with virtual edges, which makes a single trail;
+/// Hierholzer's algorithm finds it, and it breaks at the virtual edges.
+/// @note The number of breaks is the minimum for the chosen connections, but
+/// not necessarily for the cell, as the choices are made greedily.
+class EulerTrailSolver {
+ public:
+  /// @return The ordering, which breaks only between the trails.
+  Ordering Solve();
+
+  explicit EulerTrailSolver(const std::vector<Vertex>& vertices);
+
+ private:
+  struct DiffusionEdge {
+    std::size_t from;
+    std::size_t to;
+    /// @brief Placed from `from` to `to`. Absent for the virtual edges.
+    std::optional<OrientedVertex> vertex;
+  };
+
+  std::vector<DiffusionEdge> edges_;
+  /// @brief The edges incident to each vertex of the diffusion graph. A
+  /// self-loop appears twice.
+  std::vector<std::vector<std::size_t>> incident_edges_;
+
+  void AddEdge_(std::size_t from, std::size_t to,
+                std::optional<OrientedVertex> vertex);
+  /// @brief Pairs up the odd vertices of each component with virtual edges,
+  /// leaving two of them as the ends of the trail.
+  /// @return A vertex to start the trail from in each component.
+  std::vector<std::size_t> AddVirtualEdges_();
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_EULER_TRAIL_SOLVER_H_
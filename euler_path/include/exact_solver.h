@@ -0,0 +1,68 @@
+#ifndef EULER_PATH_EXACT_SOLVER_H_
+#define EULER_PATH_EXACT_SOLVER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ordering.h"
+#include "path_finder.h"
+
+namespace euler {
+
+/// @brief Finds the orderings with the minimum number of breaks (places where
+/// dummies have to be inserted) with a Held-Karp style dynamic programming.
+/// @details The state is (visited vertices, last vertex, orientation of the
+/// last vertex), where the orientation determines the nets the next vertex
+/// has to share. The states with the same number of visited vertices only
+/// depend on the previous layer, so each layer is computed in parallel.
+/// @note Both the time and the space are exponential to the number of
+/// vertices, which is why this is only for small cells.
+class ExactSolver {
+ public:
+  /// @brief The table takes 2^n * n * 4 bytes; the limit keeps it within
+  /// 80 MiB, as each thread running the cells of a library may hold one.
+  static constexpr std::size_t kMaxNumberOfVertices = 20;
+
+  /// @return For each last vertex and orientation that reaches the minimum
+  /// number of breaks, an ordering that ends there. The caller can then pick
+  /// the one with the smallest HPWL. Empty if the deadline is passed, which
+  /// is checked every few subsets of the table.
+  std::vector<Ordering> Solve(std::chrono::steady_clock::time_point deadline
+                              = std::chrono::steady_clock::time_point::max());
+
+  /// @note The number of vertices must not exceed `kMaxNumberOfVertices`.
+  ExactSolver(const std::vector<Vertex>& vertices, unsigned number_of_threads);
+
+ private:
+  static constexpr std::size_t kNumberOfOrientations = 4;
+
+  /// @note The index of the state (vertex, orientation) is
+  /// `vertex * kNumberOfOrientations + orientation`.
+  std::vector<OrientedVertex> states_;
+  /// @brief The states that can be placed right before the state, sharing
+  /// the diffusion with it.
+  std::vector<std::vector<std::size_t>> sharing_predecessors_;
+  const std::size_t number_of_vertices_;
+  const unsigned number_of_threads_;
+
+  /// @brief The minimum number of breaks of the (visited vertices, state).
+  std::vector<std::uint8_t> breaks_;
+  /// @brief The minimum number of breaks of the visited vertices, regardless
+  /// of the last state.
+  std::vector<std::uint8_t> min_breaks_;
+
+  std::size_t IndexOf_(std::uint32_t visited, std::size_t state) const {
+    return visited * states_.size() + state;
+  }
+
+  /// @note All subsets of `visited` with one less vertex must be computed.
+  void Compute_(std::uint32_t visited);
+  /// @brief Traces back from the last state to the first one.
+  Ordering Reconstruct_(std::size_t last_state) const;
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_EXACT_SOLVER_H_
@@ -0,0 +1,105 @@
+#ifndef EULER_PATH_LOCAL_SEARCH_H_
+#define EULER_PATH_LOCAL_SEARCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ordering.h"
+
+namespace euler {
+
+class Net;
+
+/// @brief Improves the HPWL of an ordering with segment reversals (2-opt),
+/// short segment moves (or-opt) and reordering of the sub-paths between the
+/// dummies. Only moves that keep the number of diffusion breaks are taken, so
+/// no sharing is lost.
+/// @details The ordering is laid out as the columns of the diffusion nets, the
+/// same as the HPWL calculation of the path finder. A move only rewrites the
+/// columns between the vertices it touches, and the columns after them don't
+/// shift since the number of breaks is kept. So a move is evaluated by
+/// recalculating only the nets that appear in those columns, with the columns
+/// of each net kept sorted to get the extent outside of the move.
+class LocalSearch {
+ public:
+  /// @brief Takes the first improving move until there's no such move, the
+  /// moves are used up, or the deadline is passed. A segment is only reversed
+  /// over or moved within a neighborhood of a few dozen vertices.
+  /// @return The improved ordering.
+  Ordering Run();
+  /// @return Whether `Run` stopped at the limit of the moves or the deadline,
+  /// with improving moves possibly left.
+  bool IsCutShort() const {
+    return is_cut_short_;
+  }
+
+  /// @param nets The nets that count in the HPWL.
+  /// @param max_moves The number of moves tried at most, which bounds the
+  /// search the same on every run, unlike the deadline.
+  /// @note The vertical wire length is taken from the first vertex, as the
+  /// width of the MOS of the same type is said to be consistent.
+  LocalSearch(Ordering ordering, const std::vector<std::shared_ptr<Net>>& nets,
+              std::size_t max_moves,
+              std::chrono::steady_clock::time_point deadline);
+
+ private:
+  /// @brief The id of the columns without a net that counts, e.g., the dummy
+  /// net.
+  static constexpr auto kNoNet = -1;
+
+  struct Extent;
+
+  Ordering ordering_;
+  const std::size_t max_moves_;
+  const std::chrono::steady_clock::time_point deadline_;
+  std::map<const Net*, int> id_of_nets_;
+  double vertical_wire_length_ = 0.0;
+
+  /// @brief The column of the left diffusion of each vertex; the right one is
+  /// the next column.
+  std::vector<std::size_t> left_columns_;
+  std::vector<int> p_net_of_columns_;
+  std::vector<int> n_net_of_columns_;
+  /// @note Sorted.
+  std::vector<std::vector<std::size_t>> p_columns_of_nets_;
+  /// @note Sorted.
+  std::vector<std::vector<std::size_t>> n_columns_of_nets_;
+  std::vector<double> hpwl_of_nets_;
+
+  bool is_cut_short_ = false;
+  /// @brief The number of moves tried, also for checking the deadline only
+  /// once in a while.
+  std::size_t number_of_moves_ = 0;
+
+  /// @brief Counts a move tried.
+  /// @return Whether the moves are used up or the deadline is passed.
+  /// @note Reads the clock only once every few moves.
+  bool IsOutOfBudget_();
+
+  int IdOf_(const std::shared_ptr<Net>& net) const;
+  bool SharesWithNext_(std::size_t i) const {
+    return CanShare(ordering_.at(i), ordering_.at(i + 1));
+  }
+  /// @brief Lays out the columns from scratch.
+  void LayOut_();
+  /// @param p The extent of the net in the P MOS.
+  /// @param n The extent of the net in the N MOS.
+  double HpwlOf_(const Extent& p, const Extent& n) const;
+
+  /// @brief Replaces the vertices in [first, last] with `window` if the number
+  /// of breaks is kept and the HPWL is reduced.
+  /// @return Whether the move is taken.
+  bool TryReplace_(std::size_t first, std::size_t last, const Ordering& window);
+  /// @brief Reverses the segment [first, last].
+  bool TryReverse_(std::size_t first, std::size_t last);
+  /// @brief Moves the segment [first, last] to right after the vertex `after`,
+  /// or to the front if `after` is -1. The segment is reversed if `reversed`.
+  bool TryMove_(std::size_t first, std::size_t last, long after, bool reversed);
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_LOCAL_SEARCH_H_
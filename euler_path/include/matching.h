@@ -0,0 +1,25 @@
+#ifndef EULER_PATH_MATCHING_H_
+#define EULER_PATH_MATCHING_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace euler {
+
+/// @brief The vertex is not matched.
+constexpr auto kUnmatched = std::numeric_limits<std::size_t>::max();
+
+/// @brief Finds a maximum matching of a bipartite graph with the
+/// Hopcroft-Karp algorithm, in O(E sqrt(V)).
+/// @param adjacency The right vertices adjacent to each left vertex. The
+/// earlier ones are preferred: they are tried first by both the greedy initial
+/// matching and the augmenting paths.
+/// @return The right vertex matched with each left vertex, or `kUnmatched`.
+std::vector<std::size_t> MaximumMatching(
+    const std::vector<std::vector<std::size_t>>& adjacency,
+    std::size_t number_of_right);
+
+}  // namespace euler
+
+#endif  // EULER_PATH_MATCHING_H_
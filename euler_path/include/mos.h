@@ -2,7 +2,9 @@
 #define EULER_PATH_MOS_H_
 
 #include <memory>
-#include <string>
+#include <string_view>
+
+#include "symbol.h"
 
 namespace euler {
 
@@ -18,17 +20,33 @@ class Mos : public std::enable_shared_from_this<Mos> {
   void RegisterToConnections();
 
   /// @note To ensure that the MOS transistors are created as a shared pointer.
-  static std::shared_ptr<Mos> Create(std::string name, Type type,
+  static std::shared_ptr<Mos> Create(Symbol name, Type type,
                                      std::shared_ptr<Net> drain,
                                      std::shared_ptr<Net> gate,
                                      std::shared_ptr<Net> source,
                                      std::shared_ptr<Net> substrate,
                                      double width, double length);
+  /// @brief Creates a dummy, which is named "Dummy" and isn't registered to
+  /// its nets.
+  static std::shared_ptr<Mos> CreateDummy(Type type,
+                                          std::shared_ptr<Net> drain,
+                                          std::shared_ptr<Net> gate,
+                                          std::shared_ptr<Net> source,
+                                          std::shared_ptr<Net> substrate,
+                                          double width, double length);
+
+  std::string_view GetName() const {
+    return SymbolTable::Instance().NameOf(name_);
+  }
 
-  std::string GetName() const {
+  Symbol GetSymbol() const {
     return name_;
   }
 
+  bool IsDummy() const {
+    return is_dummy_;
+  }
+
   Type GetType() const {
     return type_;
   }
@@ -58,7 +76,7 @@ class Mos : public std::enable_shared_from_this<Mos> {
   }
 
  private:
-  std::string name_;
+  Symbol name_;
   Type type_;
   std::shared_ptr<Net> drain_;
   std::shared_ptr<Net> gate_;
@@ -66,8 +84,9 @@ class Mos : public std::enable_shared_from_this<Mos> {
   std::shared_ptr<Net> substrate_;
   double width_;
   double length_;
+  bool is_dummy_ = false;
 
-  Mos(std::string name, Type type, std::shared_ptr<Net> drain,
+  Mos(Symbol name, Type type, std::shared_ptr<Net> drain,
       std::shared_ptr<Net> gate, std::shared_ptr<Net> source,
       std::shared_ptr<Net> substrate, double width, double length);
 };
@@ -0,0 +1,47 @@
+#ifndef EULER_PATH_ORDERING_H_
+#define EULER_PATH_ORDERING_H_
+
+#include <vector>
+
+#include "path_finder.h"
+
+namespace euler {
+
+/// @brief A vertex placed with its diffusion nets assigned to the left and
+/// right sides. The first of the edge is the net of the P MOS, the second is
+/// the net of the N MOS.
+struct OrientedVertex {
+  Vertex vertex;
+  Edge left;
+  Edge right;
+};
+
+/// @brief The transistor pairs from left to right.
+using Ordering = std::vector<OrientedVertex>;
+
+/// @return Whether `b` shares the diffusion with `a` when placed right after
+/// it, on both the P and the N side.
+inline bool CanShare(const OrientedVertex& a, const OrientedVertex& b) {
+  return a.right == b.left;
+}
+
+/// @return The 4 ways to place the vertex: flipping the P MOS and flipping the
+/// N MOS independently.
+std::vector<OrientedVertex> OrientationsOf(const Vertex& vertex);
+
+/// @brief Flips both the P MOS and the N MOS, as when a segment is reversed.
+inline OrientedVertex Flip(const OrientedVertex& v) {
+  return {v.vertex, v.right, v.left};
+}
+
+/// @brief Splits the ordering into paths wherever two consecutive vertices
+/// cannot share the diffusion.
+std::vector<Path> ToPaths(const Ordering& ordering);
+
+/// @brief The inverse of `ToPaths` followed by connecting with dummies: the
+/// dummies are dropped and the orientations are recovered from the edges.
+Ordering FromPath(const Path& path);
+
+}  // namespace euler
+
+#endif  // EULER_PATH_ORDERING_H_
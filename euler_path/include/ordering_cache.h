@@ -0,0 +1,80 @@
+#ifndef EULER_PATH_ORDERING_CACHE_H_
+#define EULER_PATH_ORDERING_CACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ordering.h"
+
+namespace euler {
+
+struct CanonicalForm;
+
+/// @brief Caches the orderings of the circuits by their canonical forms, so
+/// the circuits of the same topology, e.g., the variants of the drive
+/// strength, are solved only once.
+/// @details The orderings are also keyed by the settings they're solved with,
+/// as an ordering of the heuristic isn't the answer for a run that solves the
+/// cell exactly, and vice versa.
+/// @note Thread-safe.
+class OrderingCache {
+ public:
+  /// @param settings The options that decide the ordering, e.g., the engine
+  /// and the exact limit. Only the orderings of the same settings are looked
+  /// up.
+  explicit OrderingCache(std::string settings)
+      : settings_{std::move(settings)} {}
+
+  /// @return The ordering of the circuit of `form`. If an isomorphic circuit
+  /// is cached, its ordering is remapped onto the MOS and the nets of `form`;
+  /// otherwise `solve` is called and its result is cached. The lookup of a
+  /// circuit that is being solved waits for it instead of solving again.
+  /// @note A cached ordering that doesn't fit the circuit once remapped, e.g.,
+  /// from an edited cache file, is dropped and solved again.
+  Ordering FindOrSolve(const CanonicalForm& form,
+                       const std::function<Ordering()>& solve);
+
+  /// @brief Loads the orderings written by `Save`. The malformed entries are
+  /// skipped; the others are checked against the circuits on lookup. Those of other settings are kept for `Save`, but never looked up.
+  void Load(std::istream& in);
+  /// @brief Writes the solved orderings, one per line, along with their
+  /// settings.
+  void Save(std::ostream& out) const;
+
+ private:
+  /// @brief An oriented vertex in terms of the canonical indices of the MOS
+  /// and the nets.
+  struct Entry {
+    std::size_t p;
+    std::size_t n;
+    std::size_t left_p;
+    std::size_t left_n;
+    std::size_t right_p;
+    std::size_t right_n;
+  };
+  using CanonicalOrdering = std::vector<Entry>;
+
+  /// @return Whether each pair of the remapped ordering is a P MOS and an N
+  /// MOS of the same gate with their own diffusion nets on the sides, and
+  /// the pairs share the diffusions wherever the canonical ordering does.
+  static bool Fits_(const Ordering& ordering,
+                    const CanonicalOrdering& canonical_ordering);
+
+  const std::string settings_;
+  mutable std::mutex mutex_;
+  /// @note Keyed by the settings and the certificates.
+  std::map<std::pair<std::string, std::string>,
+           std::shared_future<CanonicalOrdering>>
+      orderings_;
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_ORDERING_CACHE_H_
@@ -0,0 +1,33 @@
+#ifndef EULER_PATH_OUTPUT_FORMATTER_H_
+#define EULER_PATH_OUTPUT_FORMATTER_H_
+
+#include <string>
+#include <vector>
+
+#include "path.h"
+#include "path_finder.h"
+
+namespace euler {
+
+/// @brief Formats the path into a string buffer, so that the cells of a
+/// library are written out at once.
+class OutputFormatter {
+ public:
+  /// @brief Appends the result to the buffer.
+  /// @note No end-of-file newline.
+  void Out();
+
+  OutputFormatter(std::string& out, const Path& path,
+                  const std::vector<Edge>& edges, double hpwl)
+      : out_{out}, path_{path}, edges_{edges}, hpwl_{hpwl} {}
+
+ private:
+  std::string& out_;
+  const Path& path_;
+  const std::vector<Edge>& edges_;
+  double hpwl_;
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_OUTPUT_FORMATTER_H_
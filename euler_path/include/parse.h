@@ -0,0 +1,30 @@
+#ifndef EULER_PATH_PARSE_H_
+#define EULER_PATH_PARSE_H_
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "circuit.h"
+
+namespace euler {
+
+/// @brief Parses the netlist, which may be a library of multiple subcircuits.
+/// @note Reentrant; the netlists can be parsed on multiple threads at once.
+/// @return The circuits in the order of the input, or nothing on a syntax
+/// error, which is reported to the standard error.
+std::optional<std::vector<Circuit>> Parse(std::istream& in);
+
+/// @brief Parses the netlist file of the same grammar as `Parse` does, but
+/// memory-maps it and scans it by hand, building the circuits without the
+/// tokens of the parser in between. Meant for the large flattened netlists.
+/// @note Reentrant.
+/// @return The circuits in the order of the input, or nothing if the file
+/// can't be read or on a syntax error, which are reported to the standard
+/// error.
+std::optional<std::vector<Circuit>> ParseMapped(const std::string& file_name);
+
+}  // namespace euler
+
+#endif  // EULER_PATH_PARSE_H_
@@ -27,7 +27,8 @@ struct PathFragment {
   std::shared_ptr<PathFragment> next;
 
   // Records only the edge used to connect to `next`, as the edge used to
-  // connect to `prev` can be retrieved from `prev`.
+  // connect to `prev` can be retrieved from `prev`. The tail may keep the
+  // nets of its right side here as a hint of how it's placed.
 
   Edge edge_to_next;
 };
@@ -45,6 +46,9 @@ struct Path {
   Path& operator=(Path&& other) noexcept = default;
 };
 
+/// @brief Reverses the path in place, with the edges following their vertices.
+void Reverse(Path& path);
+
 #ifdef DEBUG
 void PrintPath(const Path& path);
 #endif
@@ -1,19 +1,25 @@
 #ifndef EULER_PATH_PATH_FINDER_H_
 #define EULER_PATH_PATH_FINDER_H_
 
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "path_finder_stats.h"
+
 namespace euler {
 
 class Mos;
 struct Circuit;
 class Net;
+class OrderingCache;
 struct Path;
 
 using Vertex = std::pair<std::shared_ptr<Mos>, std::shared_ptr<Mos>>;
@@ -21,6 +27,57 @@ using Edge = std::pair<std::shared_ptr<Net>, std::shared_ptr<Net>>;
 using Neighbors = std::vector<Vertex>;
 using Graph = std::map<Vertex, Neighbors>;
 
+/// @brief How the cells too large for the exact solver are solved.
+enum class Engine {
+  /// @brief Hamiltonian paths over the P/N pairs, extended and rotated.
+  kHamiltonPath,
+  /// @brief Euler trails on the diffusion graph, in linear time.
+  kEulerTrail,
+};
+
+struct PathFinderOption {
+  /// @brief Cells with no more P/N pairs than this are solved exactly instead
+  /// of with the heuristic. 0 disables the exact solver.
+  std::size_t exact_limit = 16;
+  /// @note The multi-start and the rotation options are only for
+  /// `Engine::kHamiltonPath`.
+  Engine engine = Engine::kHamiltonPath;
+  /// @brief The maximum number of starts of the randomized multi-start
+  /// search. 0 means unbounded, in which case the `time_budget` has to be set.
+  /// @note The first start is always the deterministic search, so the result
+  /// never gets worse than a single start.
+  unsigned number_of_starts = 1;
+  /// @brief No more start is launched once the budget is used up. 0 means
+  /// unbounded.
+  std::chrono::milliseconds time_budget{0};
+  unsigned number_of_threads = std::thread::hardware_concurrency();
+  /// @brief The start with index i uses `seed + i` as its random seed.
+  unsigned seed = 0;
+  /// @brief The number of moves the local search on the HPWL tries at most
+  /// after the path is found. 0 disables the local search.
+  /// @note Unlike a time budget, it bounds the search the same on every run,
+  /// so the path is reproducible.
+  std::size_t local_search_moves = std::size_t{1} << 18;
+  /// @brief Also stops the local search once the time is used up. 0 means
+  /// unbounded.
+  /// @note The path then varies with where the time runs out.
+  std::chrono::milliseconds local_search_budget{0};
+  /// @brief The maximum number of successive Posa rotations tried on a path
+  /// that can no longer be extended. 1 rotates only once; 0 disables the
+  /// rotations.
+  std::size_t rotation_depth = 2;
+  /// @brief The time limit of `FindPath`. Once it's passed, the heuristic
+  /// closes off the paths found so far and chains the rest of the pairs with
+  /// the Euler trails, and no more start or local search is run. 0 means
+  /// unbounded.
+  /// @note The exact solver stops as well, and the pairs are then chained with
+  /// the Euler trails.
+  std::chrono::milliseconds time_limit{0};
+  /// @brief Shares the orderings among the circuits of the same topology.
+  /// nullptr disables the cache.
+  std::shared_ptr<OrderingCache> cache;
+};
+
 class PathFinder {
  public:
   /// @details In addressing the path finder problem, the objective is to
@@ -34,31 +91,95 @@ class PathFinder {
   /// and the HPWL.
   std::tuple<Path, std::vector<Edge>, double> FindPath();
 
-  PathFinder(const std::shared_ptr<Circuit>& circuit) : circuit_{circuit} {}
+  /// @return The counters and the timers of `FindPath`.
+  const PathFinderStats& Stats() const { return stats_; }
+
+  /// @note The circuit has to outlive the path finder.
+  PathFinder(const Circuit& circuit, PathFinderOption option = {})
+      : circuit_{circuit}, option_{option} {}
 
  private:
-  const std::shared_ptr<Circuit>& circuit_;
+  /// @brief Times the phases of the path finder separately.
+  friend class PathFinderBenchmark;
 
-  std::map<Vertex, Neighbors> adjacency_list_;
+  const Circuit& circuit_;
+  const PathFinderOption option_;
+
+  Graph adjacency_list_;
   std::vector<Vertex> vertices_;
+  /// @note Mutable, as the searches are const but still counted.
+  mutable PathFinderStats stats_;
+  /// @brief When the `time_limit` is passed.
+  std::chrono::steady_clock::time_point deadline_;
+
+  /// @brief A path with dummies inserted, scored by the number of dummies
+  /// first and then the HPWL.
+  struct Candidate;
 
+  /// @brief Finds the path from scratch, without the cache.
+  Candidate Solve_();
   void GroupVertices_();
+  /// @brief Builds the graph of the pairs, which takes quadratic time. It
+  /// stops when the time is up, leaving the graph incomplete.
   void BuildGraph_();
 
   /// @return The Hamiltonian paths for the graph. The graph may not form a
   /// single path.
+  /// @param graph The adjacency list; the order of the neighbors is the order
+  /// in which the extension is tried.
+  /// @param start_order A new path starts from the first vertex in this order
+  /// that is not yet visited.
   /// @note Our requirement is to only visit each vertex once, while the edges
   /// can be traversed multiple times. This is then in fact a Hamiltonian path
   /// problem: https://en.wikipedia.org/wiki/Hamiltonian_path.
   /// @details Here I'll be using a heuristic algorithm described in the
   /// post: https://mathoverflow.net/a/327893.
-  std::vector<Path> FindHamiltonPaths_();
+  std::vector<Path> FindHamiltonPaths_(
+      const Graph& graph, const std::vector<Vertex>& start_order) const;
+  /// @return The vertices in the order of their P MOS in the netlist, which
+  /// the deterministic search starts from.
+  /// @note Never ordered by the addresses of the MOS, which differ between
+  /// the front ends.
+  std::vector<Vertex> SortedVertices_() const;
+  /// @brief Runs the deterministic search along with the randomized ones on a
+  /// thread pool.
+  /// @return The best of all the candidates.
+  Candidate FindHamiltonPathsWithMultiStart_() const;
+  /// @brief Solves the cell with `EulerTrailSolver`.
+  Candidate FindEulerTrails_() const;
+  /// @brief Solves the cell exactly with `ExactSolver`.
+  /// @return The optimal candidate with the smallest HPWL, or nothing if the
+  /// time is up before the solver finishes.
+  std::optional<Candidate> FindOptimalPaths_() const;
+  /// @brief Runs the local search on the HPWL of the candidate.
+  /// @return The improved candidate, or the original one if it's not
+  /// improved.
+  Candidate ImproveHpwl_(Candidate candidate) const;
+  /// @brief Connects the paths with dummies and scores the result.
+  Candidate MakeCandidate_(const std::vector<Path>& paths) const;
+  /// @return The paths connected into one with the dummies.
+  Path ConnectWithDummies_(const std::vector<Path>& paths) const;
   double CalculateHpwl_(const Path& path) const;
+  /// @return Whether the time limit is passed, which is then recorded in the
+  /// stats.
+  bool IsTimeUp_() const;
 
-  /// @return The extended Hamiltonian path, if any.
-  std::optional<Path> Extend_(Path path, std::set<Vertex>& to_visit) const;
-  /// @return The family of the Posa transformations of the given path.
-  std::vector<Path> Rotate_(const Path& path) const;
+  /// @brief Extends the path in place by an unvisited neighbor of either
+  /// end.
+  /// @return Whether the path is extended.
+  bool Extend_(Path& path, std::set<Vertex>& to_visit,
+               const Graph& graph) const;
+  /// @brief Searches the Posa rotations of the path for one that can be
+  /// extended, up to `depth` successive rotations. The rotations are made in
+  /// place and undone if they lead nowhere, and a rotation is only made if
+  /// its new end vertex can extend or it's to be rotated further.
+  /// @param endpoints The end vertices already tried, which are not tried
+  /// again.
+  /// @return Whether the path is rotated and extended; otherwise the path is
+  /// left as it is.
+  bool RotateAndExtend_(Path& path, std::set<Vertex>& to_visit,
+                        const Graph& graph, std::size_t depth,
+                        std::set<Vertex>& endpoints) const;
 };
 
 }  // namespace euler
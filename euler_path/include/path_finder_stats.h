@@ -0,0 +1,73 @@
+#ifndef EULER_PATH_PATH_FINDER_STATS_H_
+#define EULER_PATH_PATH_FINDER_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace euler {
+
+/// @brief The counters and the timers of a path finder, reported with
+/// `--stats`.
+/// @note The counters are atomic, as the randomized starts of the search
+/// update them concurrently.
+struct PathFinderStats {
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  /// @brief Counted on each unvisited neighbor tried at the head.
+  std::atomic<std::uint64_t> head_extension_attempts{0};
+  std::atomic<std::uint64_t> head_extension_successes{0};
+  /// @brief Counted on each unvisited neighbor tried at the tail.
+  std::atomic<std::uint64_t> tail_extension_attempts{0};
+  std::atomic<std::uint64_t> tail_extension_successes{0};
+  std::atomic<std::uint64_t> rotations_generated{0};
+  /// @brief The rotations that an extension is tried on.
+  std::atomic<std::uint64_t> rotations_tried{0};
+  /// @brief The free nets computed by the search.
+  std::atomic<std::uint64_t> free_net_computations{0};
+  /// @brief The paths found by the searches before being connected, summed
+  /// over all the starts.
+  std::atomic<std::uint64_t> sub_paths{0};
+  std::atomic<std::uint64_t> starts{0};
+  /// @brief The dummies inserted into the final path.
+  std::size_t dummies = 0;
+  /// @brief Whether the path is remapped from an isomorphic cell.
+  bool is_cache_hit = false;
+  /// @brief Whether the search is cut short by the time limit.
+  std::atomic<bool> is_time_limit_hit{false};
+
+  Milliseconds canonical_form{};
+  Milliseconds group_vertices{};
+  Milliseconds build_graph{};
+  Milliseconds exact_solver{};
+  Milliseconds heuristic{};
+  Milliseconds local_search{};
+  Milliseconds total{};
+
+  /// @brief Writes the stats as a JSON object, with each member on its own
+  /// line led by `indent`.
+  void Out(std::ostream& out, const char* indent) const;
+};
+
+/// @brief Adds the time from construction to destruction to `elapsed`.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(PathFinderStats::Milliseconds& elapsed)
+      : elapsed_{elapsed}, start_{std::chrono::steady_clock::now()} {}
+  ~ScopedTimer() {
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  PathFinderStats::Milliseconds& elapsed_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_PATH_FINDER_STATS_H_
@@ -0,0 +1,48 @@
+#ifndef EULER_PATH_SCANNER_H_
+#define EULER_PATH_SCANNER_H_
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "y.tab.hh"
+
+namespace euler {
+
+/// @brief A lexer that recognizes the restricted subset of HSPICE netlist.
+/// @details All the states of the scanning are kept in the object, so each
+/// parse owns its scanner and multiple netlists can be scanned at once.
+/// The keywords are case insensitive, while the names keep their cases and are
+/// interned into the `SymbolTable`.
+class Scanner {
+ public:
+  /// @throw yy::parser::syntax_error on an invalid input.
+  yy::parser::symbol_type Lex();
+
+  /// @return The line of the last token, starting from 1.
+  int LineNo() const {
+    return line_no_;
+  }
+
+  explicit Scanner(std::istream& in) : in_{in} {}
+
+ private:
+  std::istream& in_;
+  int line_no_ = 1;
+  /// @brief Whether the last token is a newline, so the next one is on the
+  /// next line.
+  bool is_after_newline_ = false;
+
+  /// @brief Reused by the names, so that scanning doesn't allocate.
+  std::string name_;
+
+  /// @brief Scans the longest name that starts with `first`.
+  /// @return A view of `name_`, valid until the next name is scanned.
+  std::string_view ScanName_(char first);
+  /// @brief Scans the longest number that starts with `first`.
+  double ScanNumber_(char first);
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_SCANNER_H_
@@ -0,0 +1,70 @@
+#ifndef EULER_PATH_SYMBOL_H_
+#define EULER_PATH_SYMBOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace euler {
+
+/// @brief The id of an interned name. Equal names have equal symbols.
+using Symbol = std::uint32_t;
+
+/// @brief Interns the names of the MOS and the nets, so that each distinct
+/// name is stored once, in an arena, and the names are compared as integers.
+/// @note Thread-safe. The names are never freed, so the views returned stay
+/// valid for the whole run. The lookups of the names take no lock, as the
+/// path finders of a library look them up on many threads.
+class SymbolTable {
+ public:
+  /// @return The table shared by the whole program.
+  static SymbolTable& Instance();
+
+  /// @return The symbol of `name`, which is added if it's new.
+  Symbol Intern(std::string_view name);
+  /// @return The name of `symbol`, stored in the arena.
+  std::string_view NameOf(Symbol symbol) const;
+
+  SymbolTable() = default;
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+ private:
+  /// @note Names longer than this get a block of their own.
+  static constexpr auto kBlockSize = std::size_t{64} * 1024;
+  static constexpr auto kChunkSize = std::size_t{1024};
+
+  /// @brief The names of `kChunkSize` consecutive symbols. A chunk never
+  /// moves once it's allocated.
+  using Chunk = std::array<std::string_view, kChunkSize>;
+  using Directory = std::vector<Chunk*>;
+
+  mutable std::shared_mutex mutex_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  /// @brief The unused bytes at the end of the last block.
+  char* next_ = nullptr;
+  char* end_ = nullptr;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  std::size_t number_of_names_ = 0;
+  /// @brief The chunks as seen by the lookups. When a chunk is added, the
+  /// directory is replaced by a copy with it; the replaced ones are kept, as
+  /// a lookup may still be reading them.
+  std::atomic<const Directory*> directory_{nullptr};
+  std::vector<std::unique_ptr<Directory>> directories_;
+  std::unordered_map<std::string_view, Symbol> symbols_;
+
+  void AddChunk_();
+
+  /// @return A copy of `name` in the arena.
+  std::string_view Store_(std::string_view name);
+};
+
+}  // namespace euler
+
+#endif  // EULER_PATH_SYMBOL_H_
@@ -1,7 +1,14 @@
+#include <chrono>
 #include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iostream>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -9,101 +16,179 @@
 #include "arg.h"
 #include "circuit.h"
 #include "mos.h"
+#include "ordering_cache.h"
+#include "output_formatter.h"
+#include "parse.h"
 #include "path.h"
 #include "path_finder.h"
-#include "y.tab.hh"
-
-#ifdef DEBUG
-#include <iostream>
-#endif
+#include "path_finder_stats.h"
+#include "thread_pool.h"
 
 using namespace euler;
 
-extern FILE* yyin;
-extern void yylex_destroy();
+namespace {
+
+struct CellResult {
+  std::string path;
+  /// @note Empty unless the stats are asked for.
+  std::string stats;
+};
 
-auto circuit = std::shared_ptr<Circuit>{};
+/// @return The options that decide the path of a cell, so that a cached path
+/// is only reused by the runs that would have found it. The time limit and
+/// the time budget of the starts are left out, as the search isn't
+/// deterministic with them anyway, but that of the local search is kept, as a
+/// larger one improves the HPWL further.
+std::string CacheSettingsOf(const PathFinderOption& option) {
+  auto settings = std::ostringstream{};
+  settings << "engine="
+           << (option.engine == Engine::kEulerTrail ? "euler" : "hamilton")
+           << " exact-limit=" << option.exact_limit
+           << " rotation-depth=" << option.rotation_depth
+           << " starts=" << option.number_of_starts
+           << " seed=" << option.seed
+           << " local-search-moves=" << option.local_search_moves
+           << " local-search-ms=" << option.local_search_budget.count();
+  return settings.str();
+}
+
+}  // namespace
 
 int main(int argc, char* argv[]) {
   auto arg = HandleArguments(argc, argv);
-  auto in = fopen(arg.in.c_str(), "r");
-  if (!(yyin = in)) {
-    std::perror(argv[1]);
+  auto parsed = std::optional<std::vector<Circuit>>{};
+  if (arg.mmap) {
+    parsed = ParseMapped(arg.in);
+  } else {
+    auto in = std::ifstream{arg.in};
+    if (!in) {
+      std::perror(arg.in.c_str());
+      return 1;
+    }
+    parsed = Parse(in);
+  }
+  if (!parsed) {
     return 1;
   }
-  yy::parser parser{};
-  int ret = parser.parse();
+  const auto circuits = std::move(*parsed);
 
-  yylex_destroy();
-  fclose(in);
+#ifdef DEBUG
+  for (const auto& circuit : circuits) {
+    std::cerr << "=== Circuit " << circuit.name << " ===" << std::endl;
+    for (const auto& mos : circuit.mos) {
+      std::cerr << mos->GetName() << " " << mos->GetDrain()->GetName() << " "
+                << mos->GetGate()->GetName() << " "
+                << mos->GetSource()->GetName() << " "
+                << mos->GetSubstrate()->GetName() << std::endl;
+    }
 
-  // 0 on success, 1 otherwise
-  if (ret) {
-    return ret;
+    std::cerr << "=== Nets ===" << std::endl;
+    for (const auto& [_, net] : circuit.nets) {
+      std::cerr << net->GetName();
+      for (const auto& connection : net->Connections()) {
+        std::cerr << " " << connection.lock()->GetName();
+      }
+      std::cerr << std::endl;
+    }
   }
+#endif
 
-#ifdef DEBUG
-  std::cerr << "=== Circuit ===" << std::endl;
-  for (const auto& mos : circuit->mos) {
-    std::cerr << mos->GetName() << " " << mos->GetDrain()->GetName() << " "
-              << mos->GetGate()->GetName() << " " << mos->GetSource()->GetName()
-              << " " << mos->GetSubstrate()->GetName() << std::endl;
+  auto option = PathFinderOption{};
+  option.exact_limit = arg.exact_limit;
+  if (arg.euler_trail) {
+    option.engine = Engine::kEulerTrail;
   }
+  option.number_of_starts = arg.starts;
+  option.time_budget = std::chrono::milliseconds{arg.time_budget};
+  if (arg.threads) {
+    option.number_of_threads = arg.threads;
+  }
+  option.seed = arg.seed;
+  option.local_search_moves = arg.local_search_moves;
+  option.local_search_budget
+      = std::chrono::milliseconds{arg.local_search_budget};
+  option.rotation_depth = arg.rotation_depth;
+  option.time_limit = std::chrono::milliseconds{arg.time_limit};
 
-  std::cerr << "=== Nets ===" << std::endl;
-  for (const auto& [_, net] : circuit->nets) {
-    std::cerr << net->GetName();
-    for (const auto& connection : net->Connections()) {
-      std::cerr << " " << connection.lock()->GetName();
+  // The cells of the same topology share the path, which is remapped onto
+  // their own MOS and nets.
+  if (circuits.size() > 1 || !arg.cache.empty()) {
+    option.cache = std::make_shared<OrderingCache>(CacheSettingsOf(option));
+  }
+  if (!arg.cache.empty()) {
+    // A missing cache file is the same as an empty one.
+    if (auto cache = std::ifstream{arg.cache}) {
+      option.cache->Load(cache);
     }
-    std::cerr << std::endl;
   }
-#endif
 
-  auto path_finder = PathFinder{circuit};
-  auto [path, edges, hpwl] = path_finder.FindPath();
+  // The cells of a library are independent, so they are found in parallel.
+  // Each of them then runs on a single thread to not oversubscribe.
+  auto thread_pool = ThreadPool{option.number_of_threads};
+  if (circuits.size() > 1) {
+    option.number_of_threads = 1;
+  }
+  auto results = std::vector<std::future<CellResult>>{};
+  for (const auto& circuit : circuits) {
+    results.push_back(thread_pool.Submit([&circuit, option, &arg]() {
+      auto path_finder = PathFinder{circuit, option};
+      auto [path, edges, hpwl] = path_finder.FindPath();
+      auto out = std::string{};
+      auto output_formatter = OutputFormatter{out, path, edges, hpwl};
+      output_formatter.Out();
+      auto stats = std::ostringstream{};
+      if (arg.stats) {
+        path_finder.Stats().Out(stats, "    ");
+      }
+      return CellResult{std::move(out), stats.str()};
+    }));
+  }
 
-  auto out = std::ofstream{arg.out};
-  // // The first line gives the total HPWL of all nets in the SPICE netlist.
-  out << hpwl << '\n';
-  // The second and third lines shows the Euler path of the PMOS network in
-  // terms of instance names and net names, respectively.
-  auto prev_p_mos = path.head->vertex.first;
-  for (auto curr = path.head; curr; curr = curr->next) {
-    auto p = curr->vertex.first;
-    if (p->GetName() != prev_p_mos->GetName() || p->GetName() != "Dummy") {
-      out << p->GetName() << " ";
-    }
-    prev_p_mos = p;
+  auto cells = std::vector<CellResult>{};
+  for (auto& result : results) {
+    cells.push_back(result.get());
+  }
+  if (!arg.cache.empty()) {
+    auto cache = std::ofstream{arg.cache};
+    option.cache->Save(cache);
   }
-  out << '\n';
-  auto prev_p_net = edges.front().first;
-  for (const auto& [p, _] : edges) {
-    if (p->GetName() != prev_p_net->GetName() || p->GetName() != "Dummy") {
-      out << p->GetName() << " ";
+  if (arg.stats) {
+    std::cerr << "{\n  \"cells\": {";
+    for (auto i = std::size_t{0}; i < circuits.size(); i++) {
+      std::cerr << (i ? "," : "") << "\n    \"" << circuits.at(i).name
+                << "\": " << cells.at(i).stats;
     }
-    prev_p_net = p;
+    std::cerr << "\n  }\n}" << std::endl;
   }
-  out << '\n';
-  // The fourth and fifth lines shows the Euler path of the NMOS network in
-  // terms of instance names and net names, respectively.
-  auto prev_n_mos = path.head->vertex.second;
-  for (auto curr = path.head; curr; curr = curr->next) {
-    auto n = curr->vertex.second;
-    if (n->GetName() != prev_n_mos->GetName() || n->GetName() != "Dummy") {
-      out << n->GetName() << " ";
+
+  // Write in the order of the input.
+  if (arg.per_cell) {
+    auto dir = std::filesystem::path{arg.out};
+    std::filesystem::create_directories(dir);
+    for (auto i = std::size_t{0}; i < circuits.size(); i++) {
+      auto out = std::ofstream{dir / (circuits.at(i).name + ".out")};
+      out << cells.at(i).path;
     }
-    prev_n_mos = n;
+    return 0;
+  }
+  auto out = std::ofstream{arg.out};
+  if (circuits.size() == 1) {
+    out << cells.front().path;
+    return 0;
   }
-  out << '\n';
-  auto prev_n_net = edges.front().second;
-  for (const auto& [_, n] : edges) {
-    if (n->GetName() != prev_n_net->GetName() || n->GetName() != "Dummy") {
-      out << n->GetName() << " ";
+  // Each cell is led by its name and separated by an empty line. The library
+  // is gathered into one buffer and written at once.
+  auto buffer = std::string{};
+  for (auto i = std::size_t{0}; i < circuits.size(); i++) {
+    if (i) {
+      buffer += "\n\n";
     }
-    prev_n_net = n;
+    buffer += circuits.at(i).name;
+    buffer += '\n';
+    buffer += cells.at(i).path;
   }
-  // // No end-of-file newline.
+  // No end-of-file newline.
+  out << buffer;
 
   return 0;
 }
@@ -2,35 +2,53 @@
  * A parser that handles the restricted subset of HSPICE netlist.
  */
 
-%{
-
-#include <iostream>
-#include <map>
-#include <string>
-#include <utility>
+// Dependency code required for the value and location types;
+// inserts verbatim to the header file.
+%code requires {
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-#include "lex.yy.cc"
 #include "circuit.h"
+#include "mos.h"
+#include "symbol.h"
 
-extern std::shared_ptr<euler::Circuit> circuit;
+namespace euler {
 
-static std::map<std::string, std::shared_ptr<euler::Net>> nets;
+class Scanner;
 
-static std::shared_ptr<euler::Net> GetOrCreateNet(const std::string& name);
-static std::shared_ptr<euler::Net> GetNetOrNull(const std::string& name);
-static void RegisterNet(std::shared_ptr<euler::Net> net);
-%}
+/// @brief The states of a single parse. Nothing is shared across parses, so
+/// multiple netlists can be parsed at once.
+struct ParseContext {
+  /// @note In the order of the input.
+  std::vector<Circuit> circuits;
+  /// @brief The nets of the circuit being parsed.
+  std::unordered_map<Symbol, std::shared_ptr<Net>> nets;
+};
 
-// Dependency code required for the value and location types;
-// inserts verbatim to the header file.
-%code requires {
-#include <memory>
+}  // namespace euler
+}
+
+%code {
+#include <iostream>
+#include <istream>
+#include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
-#include "circuit.h"
-#include "mos.h"
+#include "parse.h"
+#include "scanner.h"
+
+static yy::parser::symbol_type yylex(euler::Scanner& scanner);
+
+static std::shared_ptr<euler::Net> GetOrCreateNet(
+    euler::ParseContext& context, euler::Symbol name);
+static std::shared_ptr<euler::Net> GetNetOrNull(
+    const euler::ParseContext& context, euler::Symbol name);
+static void RegisterNet(euler::ParseContext& context,
+                        std::shared_ptr<euler::Net> net);
 }
 
 %skeleton "lalr1.cc"
@@ -52,15 +70,23 @@ static void RegisterNet(std::shared_ptr<euler::Net> net);
 // parser stack reductions before discovering the syntax error.
 %define parse.lac full
 
+// Pure parser; the states are passed instead of being global.
+%param {euler::Scanner& scanner}
+%parse-param {euler::ParseContext& parse_context}
+
 /* keywords */
 %token SUBCKT ENDS
 %token <euler::Mos::Type> MOS_TYPE
 %token UNIT
 %token LENGTH WIDTH NFIN
-%token <std::string> NAME
+%token <euler::Symbol> NAME
 %token <double> NUMBER
 
+%nterm library
+%nterm circuit_list
 %nterm circuit
+%nterm eol_list
+%nterm opt_eol_list
 %nterm <std::shared_ptr<euler::Mos>>mos
 %nterm <std::vector<std::shared_ptr<euler::Mos>>> mos_list
 %nterm net_list
@@ -70,22 +96,51 @@ static void RegisterNet(std::shared_ptr<euler::Net> net);
 
 %%
 
+  /* A library may contain multiple subcircuits. */
+library:
+  circuit_list opt_eol_list
+  ;
+
+circuit_list:
+  circuit_list eol_list circuit
+  | circuit
+  ;
+
+eol_list:
+  eol_list EOL
+  | EOL
+  ;
+
+opt_eol_list:
+  %empty
+  | eol_list
+  ;
+
 circuit:
   SUBCKT NAME net_list EOL
   mos_list
   ENDS {
-    circuit = std::make_shared<euler::Circuit>($5, std::move(nets));
+    // The nets of the circuit are kept in the order of their names.
+    auto nets = std::map<std::string_view, std::shared_ptr<euler::Net>>{};
+    for (auto& [name, net] : parse_context.nets) {
+      nets.emplace(net->GetName(), std::move(net));
+    }
+    parse_context.circuits.emplace_back(
+        std::string{euler::SymbolTable::Instance().NameOf($2)},
+        std::move($5), std::move(nets));
+    // Nets are not shared across circuits.
+    parse_context.nets.clear();
   }
   ;
 
 net_list:
   net_list NAME {
-    auto net = std::make_shared<euler::Net>(std::move($2));
-    RegisterNet(net);
+    auto net = std::make_shared<euler::Net>($2);
+    RegisterNet(parse_context, net);
   }
   | NAME {
-    auto net = std::make_shared<euler::Net>(std::move($1));
-    RegisterNet(net);
+    auto net = std::make_shared<euler::Net>($1);
+    RegisterNet(parse_context, net);
   }
   ;
 
@@ -101,37 +156,60 @@ mos_list:
 
 mos:
   NAME NAME NAME NAME NAME MOS_TYPE WIDTH '=' NUMBER UNIT LENGTH '=' NUMBER UNIT NFIN '=' NUMBER {
-    auto instance_name = ($1).substr(1);  // Remove the leading 'M'.
-    $$ = euler::Mos::Create(instance_name, /* type */ $6, GetOrCreateNet($2),
-                            GetOrCreateNet($3), GetOrCreateNet($4),
-                            GetOrCreateNet($5), $9, $13);
+    auto& symbol_table = euler::SymbolTable::Instance();
+    // Remove the leading 'M'.
+    auto instance_name
+        = symbol_table.Intern(symbol_table.NameOf($1).substr(1));
+    $$ = euler::Mos::Create(instance_name, /* type */ $6,
+                            GetOrCreateNet(parse_context, $2),
+                            GetOrCreateNet(parse_context, $3),
+                            GetOrCreateNet(parse_context, $4),
+                            GetOrCreateNet(parse_context, $5), $9, $13);
     $$->RegisterToConnections();
   }
   ;
 
 %%
 
+std::optional<std::vector<euler::Circuit>> euler::Parse(std::istream& in) {
+  auto scanner = Scanner{in};
+  auto context = ParseContext{};
+  auto parser = yy::parser{scanner, context};
+  // 0 on success, 1 otherwise
+  if (parser.parse()) {
+    return std::nullopt;
+  }
+  return std::move(context.circuits);
+}
+
 void yy::parser::error(const std::string& err) {
-  std::cerr << err << std::endl;
+  std::cerr << "line " << scanner.LineNo() << ": " << err << std::endl;
+}
+
+static yy::parser::symbol_type yylex(euler::Scanner& scanner) {
+  return scanner.Lex();
 }
 
-static std::shared_ptr<euler::Net> GetOrCreateNet(const std::string& name) {
-    auto net = GetNetOrNull(name);
+static std::shared_ptr<euler::Net> GetOrCreateNet(
+    euler::ParseContext& context, euler::Symbol name) {
+    auto net = GetNetOrNull(context, name);
     if (!net) {
         net = std::make_shared<euler::Net>(name);
-        RegisterNet(net);
+        RegisterNet(context, net);
     }
     return net;
 }
 
-static std::shared_ptr<euler::Net> GetNetOrNull(const std::string& name) {
-  if (auto net = nets.find(name); net == nets.cend()) {
+static std::shared_ptr<euler::Net> GetNetOrNull(
+    const euler::ParseContext& context, euler::Symbol name) {
+  if (auto net = context.nets.find(name); net == context.nets.cend()) {
     return nullptr;
   } else {
     return net->second;
   }
 }
 
-static void RegisterNet(std::shared_ptr<euler::Net> net) {
-  nets.emplace(net->GetName(), net);
+static void RegisterNet(euler::ParseContext& context,
+                        std::shared_ptr<euler::Net> net) {
+  context.nets.emplace(net->GetSymbol(), net);
 }
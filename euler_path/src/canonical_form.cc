@@ -0,0 +1,207 @@
+#include "canonical_form.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "circuit.h"
+#include "mos.h"
+
+using namespace euler;
+
+namespace {
+
+/// @brief Bounds the search on the ties, which is exponential on circuits
+/// with many symmetric MOS, e.g., the fingers of a large driver.
+constexpr auto kMaxNumberOfLeaves = 256;
+
+enum class Pin { kGate, kDiffusion, kSubstrate };
+
+/// @brief The vertices are the MOS followed by the nets.
+struct Topology {
+  std::size_t number_of_mos;
+  std::vector<std::shared_ptr<Mos>> mos;
+  std::vector<std::shared_ptr<Net>> nets;
+  std::vector<std::vector<std::pair<Pin, std::size_t>>> adjacency;
+};
+
+/// @brief The color of each vertex, which are ranks from 0.
+using Coloring = std::vector<std::size_t>;
+
+struct Leaf {
+  std::string certificate;
+  Coloring coloring;
+};
+
+Topology TopologyOf(const Circuit& circuit) {
+  auto topology = Topology{circuit.mos.size(), circuit.mos, {}, {}};
+  auto index_of_nets = std::map<const Net*, std::size_t>{};
+  for (const auto& [_, net] : circuit.nets) {
+    index_of_nets.emplace(net.get(),
+                          topology.number_of_mos + topology.nets.size());
+    topology.nets.push_back(net);
+  }
+  topology.adjacency.resize(topology.number_of_mos + topology.nets.size());
+  const auto Connect = [&](std::size_t mos, Pin pin, const Net* net) {
+    const auto n = index_of_nets.at(net);
+    topology.adjacency.at(mos).emplace_back(pin, n);
+    topology.adjacency.at(n).emplace_back(pin, mos);
+  };
+  for (auto i = std::size_t{0}; i < topology.number_of_mos; i++) {
+    const auto& mos = topology.mos.at(i);
+    Connect(i, Pin::kGate, mos->GetGate().get());
+    Connect(i, Pin::kDiffusion, mos->GetDrain().get());
+    Connect(i, Pin::kDiffusion, mos->GetSource().get());
+    Connect(i, Pin::kSubstrate, mos->GetSubstrate().get());
+  }
+  return topology;
+}
+
+/// @return The ranks of the keys, so that equal keys have the same color and
+/// the order of the colors follows the order of the keys.
+template <typename Key>
+Coloring RankOf(const std::vector<Key>& keys) {
+  auto sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  auto coloring = Coloring(keys.size());
+  for (auto i = std::size_t{0}; i < keys.size(); i++) {
+    coloring.at(i) = static_cast<std::size_t>(
+        std::lower_bound(sorted.begin(), sorted.end(), keys.at(i))
+        - sorted.begin());
+  }
+  return coloring;
+}
+
+std::size_t NumberOfColorsOf(const Coloring& coloring) {
+  return coloring.empty()
+             ? 0
+             : *std::max_element(coloring.begin(), coloring.end()) + 1;
+}
+
+/// @brief Splits the colors by the colors of the neighbors until stable.
+/// @note The old color comes first in the key, so a refined color never
+/// moves across the colors it's split from, which keeps the result canonical.
+Coloring Refine(const Topology& topology, Coloring coloring) {
+  using Key = std::pair<std::size_t, std::vector<std::pair<Pin, std::size_t>>>;
+  auto number_of_colors = NumberOfColorsOf(coloring);
+  while (true) {
+    auto keys = std::vector<Key>{};
+    keys.reserve(coloring.size());
+    for (auto v = std::size_t{0}; v < coloring.size(); v++) {
+      auto neighbors = std::vector<std::pair<Pin, std::size_t>>{};
+      for (const auto& [pin, u] : topology.adjacency.at(v)) {
+        neighbors.emplace_back(pin, coloring.at(u));
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      keys.emplace_back(coloring.at(v), std::move(neighbors));
+    }
+    coloring = RankOf(keys);
+    if (auto refined = NumberOfColorsOf(coloring);
+        refined == number_of_colors) {
+      return coloring;
+    } else {
+      number_of_colors = refined;
+    }
+  }
+}
+
+/// @param coloring Discrete, i.e., the colors are the labels.
+std::string CertificateOf(const Topology& topology, const Coloring& coloring) {
+  auto vertex_of_labels = std::vector<std::size_t>(coloring.size());
+  for (auto v = std::size_t{0}; v < coloring.size(); v++) {
+    vertex_of_labels.at(coloring.at(v)) = v;
+  }
+  auto certificate = std::ostringstream{};
+  certificate << topology.number_of_mos << ' ' << topology.nets.size();
+  // The MOS always precede the nets, as they have smaller initial colors.
+  for (auto label = std::size_t{0}; label < topology.number_of_mos; label++) {
+    const auto v = vertex_of_labels.at(label);
+    auto pins = std::vector<std::pair<Pin, std::size_t>>{};
+    for (const auto& [pin, net] : topology.adjacency.at(v)) {
+      pins.emplace_back(pin, coloring.at(net) - topology.number_of_mos);
+    }
+    std::sort(pins.begin(), pins.end());
+    certificate << ';'
+                << (topology.mos.at(v)->GetType() == Mos::Type::kP ? 'p'
+                                                                    : 'n');
+    for (const auto& [pin, net] : pins) {
+      certificate << ' ' << static_cast<int>(pin) << ':' << net;
+    }
+  }
+  return certificate.str();
+}
+
+void Search(const Topology& topology, const Coloring& coloring,
+            std::optional<Leaf>& best, int& number_of_leaves) {
+  auto refined = Refine(topology, coloring);
+  // The first non-singleton color is the target to individualize.
+  auto sizes = std::vector<std::size_t>(NumberOfColorsOf(refined));
+  for (auto color : refined) {
+    ++sizes.at(color);
+  }
+  auto target = std::find_if(sizes.begin(), sizes.end(),
+                             [](std::size_t size) { return size > 1; });
+  if (target == sizes.end()) {
+    ++number_of_leaves;
+    auto certificate = CertificateOf(topology, refined);
+    if (!best || certificate < best->certificate) {
+      best = Leaf{std::move(certificate), std::move(refined)};
+    }
+    return;
+  }
+  const auto target_color = static_cast<std::size_t>(target - sizes.begin());
+  for (auto v = std::size_t{0}; v < refined.size(); v++) {
+    if (refined.at(v) != target_color) {
+      continue;
+    }
+    if (number_of_leaves >= kMaxNumberOfLeaves) {
+      return;
+    }
+    // Put `v` in front of the rest of its color.
+    auto keys = std::vector<std::pair<std::size_t, bool>>{};
+    keys.reserve(refined.size());
+    for (auto u = std::size_t{0}; u < refined.size(); u++) {
+      keys.emplace_back(refined.at(u), refined.at(u) == target_color && u != v);
+    }
+    Search(topology, RankOf(keys), best, number_of_leaves);
+  }
+}
+
+}  // namespace
+
+CanonicalForm euler::CanonicalFormOf(const Circuit& circuit) {
+  const auto topology = TopologyOf(circuit);
+  // The P MOS, the N MOS and the nets are never mapped onto each other.
+  auto coloring = Coloring(topology.adjacency.size(), 2);
+  for (auto i = std::size_t{0}; i < topology.number_of_mos; i++) {
+    coloring.at(i) = topology.mos.at(i)->GetType() == Mos::Type::kP ? 0 : 1;
+  }
+  coloring = RankOf(coloring);
+
+  auto best = std::optional<Leaf>{};
+  auto number_of_leaves = 0;
+  Search(topology, coloring, best, number_of_leaves);
+
+  auto form = CanonicalForm{std::move(best->certificate),
+                            std::vector<std::shared_ptr<Mos>>(
+                                topology.number_of_mos),
+                            std::vector<std::shared_ptr<Net>>(
+                                topology.nets.size())};
+  for (auto v = std::size_t{0}; v < best->coloring.size(); v++) {
+    const auto label = best->coloring.at(v);
+    if (v < topology.number_of_mos) {
+      form.mos.at(label) = topology.mos.at(v);
+    } else {
+      form.nets.at(label - topology.number_of_mos)
+          = topology.nets.at(v - topology.number_of_mos);
+    }
+  }
+  return form;
+}
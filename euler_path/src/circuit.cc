@@ -5,13 +5,22 @@ using namespace euler;
 #include <memory>
 #include <vector>
 
+#include "symbol.h"
+
+std::shared_ptr<Net> Net::CreateDummy() {
+  static const auto kDummy = SymbolTable::Instance().Intern("Dummy");
+  auto net = std::make_shared<Net>(kDummy);
+  net->is_dummy_ = true;
+  return net;
+}
+
 void Net::AddConnection(std::weak_ptr<Mos> mos) {
-  // FIXME: Linear search is slow. Use another data structure for existence
-  // checking.
-  for (const auto& m : mos_) {
-    if (m.lock() == mos.lock()) {
-      return;
-    }
+  // A MOS registers all of its pins at once, so if it's already connected,
+  // it's the last one. This keeps the power nets of the flattened netlists,
+  // which connect to most of the MOS, from being scanned on every MOS.
+  if (!mos_.empty() && !mos_.back().owner_before(mos)
+      && !mos.owner_before(mos_.back())) {
+    return;
   }
   mos_.push_back(mos);
 }
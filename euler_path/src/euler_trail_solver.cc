@@ -0,0 +1,168 @@
+#include "euler_trail_solver.h"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ordering.h"
+
+using namespace euler;
+
+namespace {
+
+constexpr auto kNone = std::numeric_limits<std::size_t>::max();
+
+using NetPair = std::pair<const Net*, const Net*>;
+
+struct NetPairHash {
+  std::size_t operator()(const NetPair& nets) const {
+    const auto hash = std::hash<const Net*>{};
+    return hash(nets.first) * 31 + hash(nets.second);
+  }
+};
+
+std::size_t FindRoot(std::vector<std::size_t>& parents, std::size_t v) {
+  while (parents.at(v) != v) {
+    // Path halving.
+    parents.at(v) = parents.at(parents.at(v));
+    v = parents.at(v);
+  }
+  return v;
+}
+
+}  // namespace
+
+EulerTrailSolver::EulerTrailSolver(const std::vector<Vertex>& vertices) {
+  auto id_of_net_pairs
+      = std::unordered_map<NetPair, std::size_t, NetPairHash>{};
+  const auto IdOf = [this, &id_of_net_pairs](const Edge& nets) {
+    auto [it, is_new] = id_of_net_pairs.try_emplace(
+        {nets.first.get(), nets.second.get()}, incident_edges_.size());
+    if (is_new) {
+      incident_edges_.emplace_back();
+    }
+    return it->second;
+  };
+  // The change in the number of odd vertices if an edge is added.
+  const auto OddnessOf = [this](std::size_t from, std::size_t to) {
+    if (from == to) {
+      return 0;
+    }
+    return (incident_edges_.at(from).size() % 2 ? -1 : 1)
+           + (incident_edges_.at(to).size() % 2 ? -1 : 1);
+  };
+  edges_.reserve(vertices.size());
+  for (const auto& vertex : vertices) {
+    // Flipping both MOS only reverses the edge, so the P MOS is kept as it
+    // is and the N MOS either follows (the first) or not (the third).
+    const auto orientations = OrientationsOf(vertex);
+    const auto& together = orientations.at(0);
+    const auto& apart = orientations.at(2);
+    const auto together_from = IdOf(together.left);
+    const auto together_to = IdOf(together.right);
+    const auto apart_from = IdOf(apart.left);
+    const auto apart_to = IdOf(apart.right);
+    if (OddnessOf(apart_from, apart_to)
+        < OddnessOf(together_from, together_to)) {
+      AddEdge_(apart_from, apart_to, apart);
+    } else {
+      AddEdge_(together_from, together_to, together);
+    }
+  }
+}
+
+Ordering EulerTrailSolver::Solve() {
+  const auto starts = AddVirtualEdges_();
+
+  // Hierholzer's algorithm. Each vertex keeps where its incident edges are
+  // scanned up to, so each edge is looked at a constant number of times.
+  auto is_used = std::vector<bool>(edges_.size());
+  auto next_incident = std::vector<std::size_t>(incident_edges_.size());
+  auto ordering = Ordering{};
+  ordering.reserve(edges_.size());
+  // (vertex, the edge it's reached through)
+  auto stack = std::vector<std::pair<std::size_t, std::size_t>>{};
+  auto trail = std::vector<std::pair<std::size_t, std::size_t>>{};
+  for (auto start : starts) {
+    stack.emplace_back(start, kNone);
+    trail.clear();
+    while (!stack.empty()) {
+      const auto [v, edge_in] = stack.back();
+      auto& next = next_incident.at(v);
+      const auto& incident_edges = incident_edges_.at(v);
+      while (next < incident_edges.size()
+             && is_used.at(incident_edges.at(next))) {
+        ++next;
+      }
+      if (next < incident_edges.size()) {
+        const auto e = incident_edges.at(next);
+        is_used.at(e) = true;
+        const auto& edge = edges_.at(e);
+        stack.emplace_back(edge.from == v ? edge.to : edge.from, e);
+      } else {
+        stack.pop_back();
+        if (edge_in != kNone) {
+          trail.emplace_back(edge_in, v);
+        }
+      }
+    }
+    // The edges are popped from the end of the trail.
+    for (auto it = trail.crbegin(); it != trail.crend(); ++it) {
+      const auto& [e, to] = *it;
+      const auto& edge = edges_.at(e);
+      // The trail breaks at a virtual edge.
+      if (!edge.vertex) {
+        continue;
+      }
+      ordering.push_back(to == edge.to ? *edge.vertex : Flip(*edge.vertex));
+    }
+  }
+  return ordering;
+}
+
+void EulerTrailSolver::AddEdge_(std::size_t from, std::size_t to,
+                                std::optional<OrientedVertex> vertex) {
+  const auto e = edges_.size();
+  edges_.push_back({from, to, std::move(vertex)});
+  incident_edges_.at(from).push_back(e);
+  incident_edges_.at(to).push_back(e);
+}
+
+std::vector<std::size_t> EulerTrailSolver::AddVirtualEdges_() {
+  const auto number_of_vertices = incident_edges_.size();
+  auto parents = std::vector<std::size_t>(number_of_vertices);
+  std::iota(parents.begin(), parents.end(), std::size_t{0});
+  for (const auto& edge : edges_) {
+    parents.at(FindRoot(parents, edge.from)) = FindRoot(parents, edge.to);
+  }
+  auto odd_vertices_of_roots
+      = std::vector<std::vector<std::size_t>>(number_of_vertices);
+  for (auto v = std::size_t{0}; v < number_of_vertices; v++) {
+    if (incident_edges_.at(v).size() % 2) {
+      odd_vertices_of_roots.at(FindRoot(parents, v)).push_back(v);
+    }
+  }
+  auto starts = std::vector<std::size_t>{};
+  for (auto v = std::size_t{0}; v < number_of_vertices; v++) {
+    if (FindRoot(parents, v) != v) {
+      continue;
+    }
+    // There's always an even number of odd vertices. A component without
+    // any makes a circuit, which can start anywhere.
+    const auto& odd_vertices = odd_vertices_of_roots.at(v);
+    if (odd_vertices.empty()) {
+      starts.push_back(v);
+      continue;
+    }
+    for (auto i = std::size_t{2}; i + 1 < odd_vertices.size(); i += 2) {
+      AddEdge_(odd_vertices.at(i), odd_vertices.at(i + 1), std::nullopt);
+    }
+    starts.push_back(odd_vertices.front());
+  }
+  return starts;
+}
@@ -0,0 +1,198 @@
+#include "exact_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "ordering.h"
+#include "thread_pool.h"
+
+using namespace euler;
+
+namespace {
+
+constexpr auto kUnknown = std::numeric_limits<std::uint8_t>::max();
+constexpr auto kNotFound = std::numeric_limits<std::size_t>::max();
+/// @brief Layers with fewer subsets are not worth the synchronization.
+constexpr auto kMinNumberOfSubsetsToParallelize = std::size_t{1024};
+/// @brief The number of subsets computed between two reads of the clock.
+constexpr auto kSubsetsPerDeadlineCheck = std::size_t{1024};
+
+bool Contains(std::uint32_t visited, std::size_t vertex) {
+  return (visited >> vertex) & 1u;
+}
+
+}  // namespace
+
+ExactSolver::ExactSolver(const std::vector<Vertex>& vertices,
+                         unsigned number_of_threads)
+    : number_of_vertices_{vertices.size()},
+      number_of_threads_{number_of_threads} {
+  assert(number_of_vertices_ <= kMaxNumberOfVertices);
+  for (const auto& vertex : vertices) {
+    auto orientations = OrientationsOf(vertex);
+    assert(orientations.size() == kNumberOfOrientations);
+    states_.insert(states_.end(), orientations.begin(), orientations.end());
+  }
+  sharing_predecessors_.resize(states_.size());
+  for (auto state = std::size_t{0}; state < states_.size(); state++) {
+    for (auto prev = std::size_t{0}; prev < states_.size(); prev++) {
+      // A vertex cannot be placed twice.
+      if (prev / kNumberOfOrientations == state / kNumberOfOrientations) {
+        continue;
+      }
+      if (CanShare(states_.at(prev), states_.at(state))) {
+        sharing_predecessors_.at(state).push_back(prev);
+      }
+    }
+  }
+}
+
+std::vector<Ordering> ExactSolver::Solve(
+    std::chrono::steady_clock::time_point deadline) {
+  const auto number_of_subsets = std::uint32_t{1} << number_of_vertices_;
+  breaks_.assign(number_of_subsets * states_.size(), kUnknown);
+  min_breaks_.assign(number_of_subsets, kUnknown);
+
+  // Group the subsets by the number of vertices they contain.
+  auto layers = std::vector<std::vector<std::uint32_t>>(number_of_vertices_
+                                                        + 1);
+  for (auto visited = std::uint32_t{1}; visited < number_of_subsets;
+       visited++) {
+    layers.at(__builtin_popcount(visited)).push_back(visited);
+  }
+  // A single vertex is a path without any break.
+  for (auto visited : layers.at(1)) {
+    for (auto state = std::size_t{0}; state < states_.size(); state++) {
+      if (Contains(visited, state / kNumberOfOrientations)) {
+        breaks_.at(IndexOf_(visited, state)) = 0;
+      }
+    }
+    min_breaks_.at(visited) = 0;
+  }
+
+  auto thread_pool = std::optional<ThreadPool>{};
+  if (number_of_threads_ > 1) {
+    thread_pool.emplace(number_of_threads_);
+  }
+  const auto IsPastDeadline = [deadline]() {
+    return std::chrono::steady_clock::now() >= deadline;
+  };
+  auto is_past_deadline = std::atomic<bool>{false};
+  for (auto k = std::size_t{2}; k <= number_of_vertices_; k++) {
+    const auto& layer = layers.at(k);
+    if (!thread_pool || layer.size() < kMinNumberOfSubsetsToParallelize) {
+      for (auto i = std::size_t{0}; i < layer.size(); i++) {
+        if (i % kSubsetsPerDeadlineCheck == 0 && IsPastDeadline()) {
+          return {};
+        }
+        Compute_(layer.at(i));
+      }
+      continue;
+    }
+    // Split the layer into a few chunks per thread for load balancing.
+    const auto chunk_size
+        = std::max(std::size_t{1}, layer.size() / (thread_pool->Size() * 4));
+    auto chunks = std::vector<std::future<void>>{};
+    for (auto begin = std::size_t{0}; begin < layer.size();
+         begin += chunk_size) {
+      const auto end = std::min(layer.size(), begin + chunk_size);
+      chunks.push_back(thread_pool->Submit([&, begin, end]() {
+        for (auto i = begin; i < end; i++) {
+          if ((i - begin) % kSubsetsPerDeadlineCheck == 0
+              && (is_past_deadline || IsPastDeadline())) {
+            is_past_deadline = true;
+            return;
+          }
+          Compute_(layer.at(i));
+        }
+      }));
+    }
+    for (auto& chunk : chunks) {
+      chunk.get();
+    }
+    if (is_past_deadline) {
+      return {};
+    }
+  }
+
+  const auto all_visited = number_of_subsets - 1;
+  auto orderings = std::vector<Ordering>{};
+  for (auto state = std::size_t{0}; state < states_.size(); state++) {
+    if (breaks_.at(IndexOf_(all_visited, state))
+        == min_breaks_.at(all_visited)) {
+      orderings.push_back(Reconstruct_(state));
+    }
+  }
+  return orderings;
+}
+
+void ExactSolver::Compute_(std::uint32_t visited) {
+  auto min_breaks = kUnknown;
+  for (auto vertex = std::size_t{0}; vertex < number_of_vertices_; vertex++) {
+    if (!Contains(visited, vertex)) {
+      continue;
+    }
+    const auto prev_visited = visited & ~(std::uint32_t{1} << vertex);
+    for (auto state = vertex * kNumberOfOrientations;
+         state < (vertex + 1) * kNumberOfOrientations; state++) {
+      // Either breaks after the best of the previous subset, or shares the
+      // diffusion with the previous vertex.
+      auto breaks = static_cast<std::uint8_t>(min_breaks_.at(prev_visited) + 1);
+      for (auto prev : sharing_predecessors_.at(state)) {
+        if (Contains(prev_visited, prev / kNumberOfOrientations)) {
+          breaks = std::min(breaks, breaks_.at(IndexOf_(prev_visited, prev)));
+        }
+      }
+      breaks_.at(IndexOf_(visited, state)) = breaks;
+      min_breaks = std::min(min_breaks, breaks);
+    }
+  }
+  min_breaks_.at(visited) = min_breaks;
+}
+
+Ordering ExactSolver::Reconstruct_(std::size_t last_state) const {
+  auto ordering = Ordering{};
+  auto visited = (std::uint32_t{1} << number_of_vertices_) - 1;
+  auto state = last_state;
+  auto breaks = breaks_.at(IndexOf_(visited, state));
+  while (true) {
+    ordering.push_back(states_.at(state));
+    const auto prev_visited
+        = visited & ~(std::uint32_t{1} << (state / kNumberOfOrientations));
+    if (!prev_visited) {
+      break;
+    }
+    // Prefer sharing the diffusion, which doesn't cost a break.
+    auto prev_state = kNotFound;
+    for (auto prev : sharing_predecessors_.at(state)) {
+      if (Contains(prev_visited, prev / kNumberOfOrientations)
+          && breaks_.at(IndexOf_(prev_visited, prev)) == breaks) {
+        prev_state = prev;
+        break;
+      }
+    }
+    if (prev_state == kNotFound) {
+      for (auto prev = std::size_t{0}; prev < states_.size(); prev++) {
+        if (Contains(prev_visited, prev / kNumberOfOrientations)
+            && breaks_.at(IndexOf_(prev_visited, prev)) + 1 == breaks) {
+          prev_state = prev;
+          break;
+        }
+      }
+      --breaks;
+    }
+    assert(prev_state != kNotFound && "the table is inconsistent");
+    state = prev_state;
+    visited = prev_visited;
+  }
+  // Traced from the last to the first.
+  std::reverse(ordering.begin(), ordering.end());
+  return ordering;
+}
@@ -0,0 +1,467 @@
+#include "local_search.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "design_rule.h"
+#include "mos.h"
+#include "ordering.h"
+
+using namespace euler;
+
+namespace {
+
+/// @brief Moves that improve less than this are considered as noise of the
+/// floating point arithmetic.
+constexpr auto kEpsilon = 1e-9;
+/// @brief The longest segment that or-opt moves. Longer segments are moved
+/// only as whole sub-paths.
+constexpr auto kMaxOrOptLength = std::size_t{3};
+/// @brief The farthest, in vertices, that a segment is reversed over or moved
+/// away. A move rewrites all the columns in between, so a far move costs as
+/// much as the distance, and it rarely improves the HPWL of a large cell.
+constexpr auto kNeighborhood = 64L;
+/// @brief The number of moves tried between two reads of the clock.
+constexpr auto kMovesPerDeadlineCheck = std::size_t{256};
+
+bool IsPast(std::chrono::steady_clock::time_point deadline) {
+  return std::chrono::steady_clock::now() >= deadline;
+}
+
+Ordering ReversedOf(Ordering::const_iterator first,
+                    Ordering::const_iterator last) {
+  auto reversed = Ordering{};
+  reversed.reserve(last - first);
+  for (auto it = last; it != first;) {
+    reversed.push_back(Flip(*--it));
+  }
+  return reversed;
+}
+
+}  // namespace
+
+/// @brief The number of columns a net appears in, and the extent of them.
+struct LocalSearch::Extent {
+  std::size_t count = 0;
+  std::size_t min = std::numeric_limits<std::size_t>::max();
+  std::size_t max = 0;
+
+  void Add(std::size_t column) {
+    ++count;
+    min = std::min(min, column);
+    max = std::max(max, column);
+  }
+
+  void Merge(const Extent& other) {
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+
+  /// @return The extent of the sorted `columns` excluding those in [begin,
+  /// end).
+  static Extent Outside(const std::vector<std::size_t>& columns,
+                        std::size_t begin, std::size_t end) {
+    auto extent = Extent{};
+    auto inside_begin
+        = std::lower_bound(columns.begin(), columns.end(), begin);
+    auto inside_end = std::lower_bound(inside_begin, columns.end(), end);
+    extent.count = columns.size() - (inside_end - inside_begin);
+    if (extent.count) {
+      extent.min
+          = inside_begin != columns.begin() ? columns.front() : *inside_end;
+      extent.max = inside_end != columns.end() ? columns.back()
+                                               : *std::prev(inside_begin);
+    }
+    return extent;
+  }
+};
+
+LocalSearch::LocalSearch(Ordering ordering,
+                         const std::vector<std::shared_ptr<Net>>& nets,
+                         std::size_t max_moves,
+                         std::chrono::steady_clock::time_point deadline)
+    : ordering_{std::move(ordering)},
+      max_moves_{max_moves},
+      deadline_{deadline} {
+  for (const auto& net : nets) {
+    id_of_nets_.emplace(net.get(), static_cast<int>(id_of_nets_.size()));
+  }
+  if (!ordering_.empty()) {
+    const auto& [p, n] = ordering_.front().vertex;
+    vertical_wire_length_
+        = kVerticalWidthIncrement + (p->GetWidth() + n->GetWidth()) / 2;
+  }
+}
+
+Ordering LocalSearch::Run() {
+  const auto n = ordering_.size();
+  if (n < 2) {
+    return std::move(ordering_);
+  }
+  LayOut_();
+
+  // The destinations of a move, clamped to the neighborhood of the segment
+  // [first, last].
+  const auto FirstAfter = [](std::size_t first) {
+    return std::max(-1L, static_cast<long>(first) - kNeighborhood);
+  };
+  const auto LastAfter = [n](std::size_t last) {
+    return std::min(static_cast<long>(n) - 1,
+                    static_cast<long>(last) + kNeighborhood);
+  };
+
+  auto improved = true;
+  while (improved && !IsOutOfBudget_()) {
+    improved = false;
+
+    // 2-opt: reverse a segment in place.
+    for (auto first = std::size_t{0}; first < n && !IsOutOfBudget_();
+         first++) {
+      for (auto last = first + 1;
+           last < n && static_cast<long>(last - first) <= kNeighborhood
+           && !IsOutOfBudget_();
+           last++) {
+        improved |= TryReverse_(first, last);
+      }
+    }
+
+    // Or-opt: move a short segment elsewhere, possibly reversed.
+    for (auto length = std::size_t{1}; length <= kMaxOrOptLength; length++) {
+      for (auto first = std::size_t{0}; first + length <= n
+                                        && !IsOutOfBudget_();
+           first++) {
+        const auto last = first + length - 1;
+        for (auto after = FirstAfter(first);
+             after <= LastAfter(last) && !IsOutOfBudget_(); after++) {
+          if (after >= static_cast<long>(first) - 1
+              && after <= static_cast<long>(last)) {
+            continue;
+          }
+          improved |= TryMove_(first, last, after, false)
+                      || TryMove_(first, last, after, true);
+        }
+      }
+    }
+
+    // Reorder the sub-paths: move a whole sub-path to another break.
+    auto sub_paths = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (auto first = std::size_t{0}, i = std::size_t{0}; i < n; i++) {
+      if (i + 1 == n || !SharesWithNext_(i)) {
+        sub_paths.emplace_back(first, i);
+        first = i + 1;
+      }
+    }
+    for (const auto& [first, last] : sub_paths) {
+      // The shorter ones are covered by or-opt. The sub-paths may no longer
+      // be separated by breaks after some moves, but the moves stay valid as
+      // they're checked anyway.
+      if (last - first + 1 <= kMaxOrOptLength) {
+        continue;
+      }
+      for (auto after = FirstAfter(first);
+           after <= LastAfter(last) && !IsOutOfBudget_(); after++) {
+        if (after >= static_cast<long>(first) - 1
+            && after <= static_cast<long>(last)) {
+          continue;
+        }
+        if (after != -1 && after + 1 != static_cast<long>(n)
+            && SharesWithNext_(after)) {
+          continue;
+        }
+        improved |= TryMove_(first, last, after, false)
+                    || TryMove_(first, last, after, true);
+      }
+    }
+  }
+  return std::move(ordering_);
+}
+
+bool LocalSearch::IsOutOfBudget_() {
+  if (!is_cut_short_) {
+    is_cut_short_ = number_of_moves_ >= max_moves_
+                    || (number_of_moves_ % kMovesPerDeadlineCheck == 0
+                        && IsPast(deadline_));
+    number_of_moves_++;
+  }
+  return is_cut_short_;
+}
+
+int LocalSearch::IdOf_(const std::shared_ptr<Net>& net) const {
+  if (auto it = id_of_nets_.find(net.get()); it != id_of_nets_.cend()) {
+    return it->second;
+  }
+  return kNoNet;
+}
+
+void LocalSearch::LayOut_() {
+  left_columns_.assign(ordering_.size(), 0);
+  p_net_of_columns_.clear();
+  n_net_of_columns_.clear();
+  const auto PushColumn = [this](const Edge& edge) {
+    p_net_of_columns_.push_back(IdOf_(edge.first));
+    n_net_of_columns_.push_back(IdOf_(edge.second));
+  };
+  for (auto i = std::size_t{0}; i < ordering_.size(); i++) {
+    if (i != 0 && SharesWithNext_(i - 1)) {
+      // The left diffusion is the right diffusion of the previous one.
+      left_columns_.at(i) = p_net_of_columns_.size() - 1;
+    } else {
+      if (i != 0) {
+        // The dummy net between the 2 dummies.
+        p_net_of_columns_.push_back(kNoNet);
+        n_net_of_columns_.push_back(kNoNet);
+      }
+      left_columns_.at(i) = p_net_of_columns_.size();
+      PushColumn(ordering_.at(i).left);
+    }
+    PushColumn(ordering_.at(i).right);
+  }
+
+  p_columns_of_nets_.assign(id_of_nets_.size(), {});
+  n_columns_of_nets_.assign(id_of_nets_.size(), {});
+  for (auto column = std::size_t{0}; column < p_net_of_columns_.size();
+       column++) {
+    if (auto id = p_net_of_columns_.at(column); id != kNoNet) {
+      p_columns_of_nets_.at(id).push_back(column);
+    }
+    if (auto id = n_net_of_columns_.at(column); id != kNoNet) {
+      n_columns_of_nets_.at(id).push_back(column);
+    }
+  }
+  hpwl_of_nets_.assign(id_of_nets_.size(), 0.0);
+  for (auto id = std::size_t{0}; id < id_of_nets_.size(); id++) {
+    auto p_extent = Extent{};
+    for (auto column : p_columns_of_nets_.at(id)) {
+      p_extent.Add(column);
+    }
+    auto n_extent = Extent{};
+    for (auto column : n_columns_of_nets_.at(id)) {
+      n_extent.Add(column);
+    }
+    hpwl_of_nets_.at(id) = HpwlOf_(p_extent, n_extent);
+  }
+}
+
+double LocalSearch::HpwlOf_(const Extent& p, const Extent& n) const {
+  // Same as the HPWL calculation of the path finder.
+  auto hpwl = 0.0;
+  auto extent = Extent{};
+  if (p.count && n.count) {
+    extent = p;
+    extent.Merge(n);
+    hpwl = kUnitHorizontalWidth * (extent.max - extent.min)
+           + vertical_wire_length_;
+  } else if (p.count > 1 && !n.count) {
+    extent = p;
+    hpwl = kUnitHorizontalWidth * (extent.max - extent.min);
+  } else if (!p.count && n.count > 1) {
+    extent = n;
+    hpwl = kUnitHorizontalWidth * (extent.max - extent.min);
+  } else {
+    return 0.0;
+  }
+  auto adjustment = (extent.max == p_net_of_columns_.size() - 1)  // the end
+                    + (extent.min == 0);                          // the start
+  return hpwl + (-kGateSpacing + kHorizontalExtension) / 2.0 * adjustment;
+}
+
+bool LocalSearch::TryReplace_(std::size_t first, std::size_t last,
+                              const Ordering& window) {
+  assert(window.size() == last - first + 1);
+  const auto n = ordering_.size();
+  const auto* before = first != 0 ? &ordering_.at(first - 1) : nullptr;
+  const auto* after = last + 1 != n ? &ordering_.at(last + 1) : nullptr;
+
+  // The number of breaks has to be kept, so that no sharing is lost and the
+  // columns outside of the window don't shift.
+  auto old_shares = std::size_t{0};
+  for (auto i = first != 0 ? first - 1 : first; i <= last && i + 1 < n; i++) {
+    old_shares += SharesWithNext_(i);
+  }
+  auto new_shares = std::size_t{0};
+  for (auto k = std::size_t{0}; k < window.size(); k++) {
+    const auto* prev = k != 0 ? &window.at(k - 1) : before;
+    new_shares += prev && CanShare(*prev, window.at(k));
+  }
+  new_shares += after && CanShare(window.back(), *after);
+  if (old_shares != new_shares) {
+    return false;
+  }
+
+  // The columns in [begin, end) are rewritten by the window.
+  const auto begin = before ? left_columns_.at(first - 1) + 2 : 0;
+  const auto end
+      = after ? left_columns_.at(last + 1) : p_net_of_columns_.size();
+  auto p_nets = std::vector<int>(end - begin, kNoNet);
+  auto n_nets = std::vector<int>(end - begin, kNoNet);
+  const auto Write = [&](std::size_t column, const Edge& edge) {
+    if (column >= begin && column < end) {
+      p_nets.at(column - begin) = IdOf_(edge.first);
+      n_nets.at(column - begin) = IdOf_(edge.second);
+    }
+  };
+  auto new_left_columns = std::vector<std::size_t>(window.size());
+  // The right column of the previous vertex.
+  auto column = before ? begin - 1 : 0;
+  for (auto k = std::size_t{0}; k < window.size(); k++) {
+    const auto* prev = k != 0 ? &window.at(k - 1) : before;
+    if (!prev) {
+      new_left_columns.at(k) = 0;
+      Write(0, window.at(k).left);
+    } else if (CanShare(*prev, window.at(k))) {
+      new_left_columns.at(k) = column;
+    } else {
+      // The dummy net takes a column; it's left as no net.
+      new_left_columns.at(k) = column + 2;
+      Write(new_left_columns.at(k), window.at(k).left);
+    }
+    column = new_left_columns.at(k) + 1;
+    Write(column, window.at(k).right);
+  }
+  assert((after ? column + (CanShare(window.back(), *after) ? 0 : 2)
+                : column + 1)
+         == end);
+
+  // Only the nets that appear in the window are affected.
+  auto affected_nets = std::vector<int>{};
+  for (auto column = begin; column < end; column++) {
+    affected_nets.push_back(p_net_of_columns_.at(column));
+    affected_nets.push_back(n_net_of_columns_.at(column));
+    affected_nets.push_back(p_nets.at(column - begin));
+    affected_nets.push_back(n_nets.at(column - begin));
+  }
+  std::sort(affected_nets.begin(), affected_nets.end());
+  affected_nets.erase(std::unique(affected_nets.begin(), affected_nets.end()),
+                      affected_nets.end());
+  affected_nets.erase(
+      std::remove(affected_nets.begin(), affected_nets.end(), kNoNet),
+      affected_nets.end());
+
+  auto new_hpwl_of_nets = std::vector<double>{};
+  auto delta = 0.0;
+  for (auto id : affected_nets) {
+    auto p_extent = Extent::Outside(p_columns_of_nets_.at(id), begin, end);
+    auto n_extent = Extent::Outside(n_columns_of_nets_.at(id), begin, end);
+    for (auto column = begin; column < end; column++) {
+      if (p_nets.at(column - begin) == id) {
+        p_extent.Add(column);
+      }
+      if (n_nets.at(column - begin) == id) {
+        n_extent.Add(column);
+      }
+    }
+    new_hpwl_of_nets.push_back(HpwlOf_(p_extent, n_extent));
+    delta += new_hpwl_of_nets.back() - hpwl_of_nets_.at(id);
+  }
+  if (delta > -kEpsilon) {
+    return false;
+  }
+
+  // Take the move.
+  std::copy(window.begin(), window.end(), ordering_.begin() + first);
+  std::copy(new_left_columns.begin(), new_left_columns.end(),
+            left_columns_.begin() + first);
+  std::copy(p_nets.begin(), p_nets.end(), p_net_of_columns_.begin() + begin);
+  std::copy(n_nets.begin(), n_nets.end(), n_net_of_columns_.begin() + begin);
+  const auto UpdateColumns = [begin, end](std::vector<std::size_t>& columns,
+                                          const std::vector<int>& nets,
+                                          int id) {
+    auto inside_begin = std::lower_bound(columns.begin(), columns.end(), begin);
+    auto inside_end = std::lower_bound(inside_begin, columns.end(), end);
+    auto position = columns.erase(inside_begin, inside_end);
+    for (auto column = begin; column < end; column++) {
+      if (nets.at(column - begin) == id) {
+        position = std::next(columns.insert(position, column));
+      }
+    }
+  };
+  for (auto i = std::size_t{0}; i < affected_nets.size(); i++) {
+    auto id = affected_nets.at(i);
+    UpdateColumns(p_columns_of_nets_.at(id), p_nets, id);
+    UpdateColumns(n_columns_of_nets_.at(id), n_nets, id);
+    hpwl_of_nets_.at(id) = new_hpwl_of_nets.at(i);
+  }
+  return true;
+}
+
+bool LocalSearch::TryReverse_(std::size_t first, std::size_t last) {
+  const auto n = ordering_.size();
+  // The sharing inside the segment is kept by reversing; check only the two
+  // ends before building the window.
+  auto old_shares = (first != 0 && SharesWithNext_(first - 1))
+                    + (last + 1 != n && SharesWithNext_(last));
+  auto new_shares
+      = (first != 0
+         && CanShare(ordering_.at(first - 1), Flip(ordering_.at(last))))
+        + (last + 1 != n
+           && CanShare(Flip(ordering_.at(first)), ordering_.at(last + 1)));
+  if (old_shares != new_shares) {
+    return false;
+  }
+  return TryReplace_(first, last,
+                     ReversedOf(ordering_.begin() + first,
+                                ordering_.begin() + last + 1));
+}
+
+bool LocalSearch::TryMove_(std::size_t first, std::size_t last, long after,
+                           bool reversed) {
+  const auto n = static_cast<long>(ordering_.size());
+  const auto segment_first
+      = reversed ? Flip(ordering_.at(last)) : ordering_.at(first);
+  const auto segment_last
+      = reversed ? Flip(ordering_.at(first)) : ordering_.at(last);
+  // Only the 3 junctions around the segment and the destination change; check
+  // them before building the window.
+  if (after < static_cast<long>(first)) {
+    auto old_shares = (after != -1 && SharesWithNext_(after))
+                      + SharesWithNext_(first - 1)
+                      + (static_cast<long>(last) + 1 != n
+                         && SharesWithNext_(last));
+    auto new_shares
+        = (after != -1 && CanShare(ordering_.at(after), segment_first))
+          + CanShare(segment_last, ordering_.at(after + 1))
+          + (static_cast<long>(last) + 1 != n
+             && CanShare(ordering_.at(first - 1), ordering_.at(last + 1)));
+    if (old_shares != new_shares) {
+      return false;
+    }
+    auto window = reversed ? ReversedOf(ordering_.begin() + first,
+                                        ordering_.begin() + last + 1)
+                           : Ordering(ordering_.begin() + first,
+                                      ordering_.begin() + last + 1);
+    window.insert(window.end(), ordering_.begin() + after + 1,
+                  ordering_.begin() + first);
+    return TryReplace_(after + 1, last, window);
+  }
+
+  auto old_shares = (first != 0 && SharesWithNext_(first - 1))
+                    + SharesWithNext_(last)
+                    + (after + 1 != n && SharesWithNext_(after));
+  auto new_shares
+      = (first != 0
+         && CanShare(ordering_.at(first - 1), ordering_.at(last + 1)))
+        + CanShare(ordering_.at(after), segment_first)
+        + (after + 1 != n && CanShare(segment_last, ordering_.at(after + 1)));
+  if (old_shares != new_shares) {
+    return false;
+  }
+  auto window
+      = Ordering(ordering_.begin() + last + 1, ordering_.begin() + after + 1);
+  if (reversed) {
+    auto segment = ReversedOf(ordering_.begin() + first,
+                              ordering_.begin() + last + 1);
+    window.insert(window.end(), segment.begin(), segment.end());
+  } else {
+    window.insert(window.end(), ordering_.begin() + first,
+                  ordering_.begin() + last + 1);
+  }
+  return TryReplace_(first, after, window);
+}
@@ -0,0 +1,443 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "circuit.h"
+#include "mos.h"
+#include "parse.h"
+#include "symbol.h"
+
+using namespace euler;
+
+namespace {
+
+/// @brief A read-only mapping of a whole file.
+class MappedFile {
+ public:
+  bool IsOpen() const {
+    return is_open_;
+  }
+
+  std::string_view Content() const {
+    return {static_cast<const char*>(data_), size_};
+  }
+
+  /// @note Not open if the file can't be opened or mapped, with `errno` set.
+  explicit MappedFile(const char* file_name) {
+    const auto fd = open(file_name, O_RDONLY);
+    if (fd == -1) {
+      return;
+    }
+    struct stat status;
+    if (fstat(fd, &status) == 0) {
+      size_ = static_cast<std::size_t>(status.st_size);
+      // An empty file can't be mapped, and has nothing to map anyway.
+      if (size_ == 0) {
+        is_open_ = true;
+      } else if (auto* data
+                 = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                 data != MAP_FAILED) {
+        data_ = data;
+        is_open_ = true;
+        // The netlist is scanned once from the front.
+        madvise(data_, size_, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      munmap(data_, size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+ private:
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+  bool is_open_ = false;
+};
+
+/// @brief Reported as "line N: what" as the parser does.
+struct SyntaxError : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+bool IsNameStart(char c) {
+  return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsNamePart(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsDigit(char c) {
+  return std::isdigit(static_cast<unsigned char>(c));
+}
+
+/// @return Whether `word` is `keyword` ignoring the case. `keyword` is in
+/// lower case.
+bool IsKeyword(std::string_view word, std::string_view keyword) {
+  if (word.size() != keyword.size()) {
+    return false;
+  }
+  for (auto i = std::size_t{0}; i < word.size(); i++) {
+    if (std::tolower(static_cast<unsigned char>(word[i])) != keyword[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Scans and parses the mapped netlist in a single pass, with the
+/// same tokens and grammar as `Scanner` and parser.y. The tokens are views
+/// of the mapping, so nothing is copied but the interned names.
+class MappedParser {
+ public:
+  std::vector<Circuit> ParseLibrary() {
+    auto circuits = std::vector<Circuit>{};
+    Next_();
+    while (true) {
+      circuits.push_back(ParseCircuit_());
+      if (token_.kind == Kind::kEof) {
+        return circuits;
+      }
+      Expect_(Kind::kEol);
+      while (token_.kind == Kind::kEol) {
+        Next_();
+      }
+      if (token_.kind == Kind::kEof) {
+        return circuits;
+      }
+    }
+  }
+
+  /// @return The line of the last token, starting from 1.
+  int LineNo() const {
+    return line_no_;
+  }
+
+  explicit MappedParser(std::string_view content)
+      : next_{content.data()}, end_{content.data() + content.size()} {}
+
+ private:
+  enum class Kind {
+    kSubckt,
+    kEnds,
+    kMosType,
+    kUnit,
+    kLength,
+    kWidth,
+    kNfin,
+    kName,
+    kNumber,
+    kEquals,
+    kEol,
+    kEof,
+  };
+
+  struct Token {
+    Kind kind;
+    /// @note Of the names only.
+    std::string_view name;
+    /// @note Of the MOS types only.
+    Mos::Type type;
+    /// @note Of the numbers only.
+    double number;
+  };
+
+  const char* next_;
+  const char* end_;
+  Token token_{};
+  int line_no_ = 1;
+  /// @brief Whether the last token is a newline, so the next one is on the
+  /// next line.
+  bool is_after_newline_ = false;
+  /// @brief The nets of the circuit being parsed.
+  /// @note Keyed by the names in the mapping, so that only the new nets are
+  /// interned, instead of looking up the shared table on every pin.
+  std::unordered_map<std::string_view, std::shared_ptr<Net>> nets_;
+
+  static const char* NameOf_(Kind kind) {
+    switch (kind) {
+      case Kind::kSubckt:
+        return "SUBCKT";
+      case Kind::kEnds:
+        return "ENDS";
+      case Kind::kMosType:
+        return "MOS_TYPE";
+      case Kind::kUnit:
+        return "UNIT";
+      case Kind::kLength:
+        return "LENGTH";
+      case Kind::kWidth:
+        return "WIDTH";
+      case Kind::kNfin:
+        return "NFIN";
+      case Kind::kName:
+        return "NAME";
+      case Kind::kNumber:
+        return "NUMBER";
+      case Kind::kEquals:
+        return "'='";
+      case Kind::kEol:
+        return "EOL";
+      case Kind::kEof:
+        return "EOF";
+    }
+    return "";
+  }
+
+  /// @brief Scans the next token into `token_`.
+  /// @throw SyntaxError on an invalid input.
+  void Next_() {
+    if (is_after_newline_) {
+      ++line_no_;
+      is_after_newline_ = false;
+    }
+    while (next_ != end_
+           && (*next_ == ' ' || *next_ == '\t' || *next_ == '\r')) {
+      ++next_;
+    }
+    if (next_ == end_) {
+      token_.kind = Kind::kEof;
+      return;
+    }
+    const auto c = *next_++;
+    if (c == '\n') {
+      is_after_newline_ = true;
+      token_.kind = Kind::kEol;
+      return;
+    }
+    if (c == '=') {
+      token_.kind = Kind::kEquals;
+      return;
+    }
+    /* keywords */
+    if (c == '.') {
+      if (next_ != end_ && IsNameStart(*next_)) {
+        const auto word = ScanName_(next_++);
+        if (IsKeyword(word, "subckt")) {
+          token_.kind = Kind::kSubckt;
+          return;
+        }
+        if (IsKeyword(word, "ends")) {
+          token_.kind = Kind::kEnds;
+          return;
+        }
+      }
+      throw SyntaxError{"Invalid input: ."};
+    }
+    if (IsNameStart(c)) {
+      const auto word = ScanName_(next_ - 1);
+      // Note: several keywords can also be matched as a name.
+      // We have them take the priority.
+      if (IsKeyword(word, "pmos_rvt")) {
+        token_.kind = Kind::kMosType;
+        token_.type = Mos::Type::kP;
+      } else if (IsKeyword(word, "nmos_rvt")) {
+        token_.kind = Kind::kMosType;
+        token_.type = Mos::Type::kN;
+      } else if (IsKeyword(word, "n")) {
+        // support only nano meter
+        token_.kind = Kind::kUnit;
+      } else if (IsKeyword(word, "l")) {
+        token_.kind = Kind::kLength;
+      } else if (IsKeyword(word, "w")) {
+        token_.kind = Kind::kWidth;
+      } else if (IsKeyword(word, "nfin")) {
+        token_.kind = Kind::kNfin;
+      } else {
+        token_.kind = Kind::kName;
+        token_.name = word;
+      }
+      return;
+    }
+    if (IsDigit(c)) {
+      token_.kind = Kind::kNumber;
+      token_.number = ScanNumber_(next_ - 1);
+      return;
+    }
+    throw SyntaxError{"Invalid input: " + std::string(1, c)};
+  }
+
+  /// @brief Scans the longest name from `first`.
+  std::string_view ScanName_(const char* first) {
+    while (next_ != end_ && IsNamePart(*next_)) {
+      ++next_;
+    }
+    return {first, static_cast<std::size_t>(next_ - first)};
+  }
+
+  /// @brief Scans the longest number from `first`, which is a positive
+  /// integer or floating point number.
+  double ScanNumber_(const char* first) {
+    while (next_ != end_ && IsDigit(*next_)) {
+      ++next_;
+    }
+    // The dot is part of the number only if digits follow.
+    if (next_ != end_ && *next_ == '.' && next_ + 1 != end_
+        && IsDigit(next_[1])) {
+      next_ += 2;
+      while (next_ != end_ && IsDigit(*next_)) {
+        ++next_;
+      }
+    }
+    auto number = 0.0;
+    std::from_chars(first, next_, number);
+    return number;
+  }
+
+  /// @brief Checks the kind of the current token and moves past it.
+  /// @throw SyntaxError if the token is of another kind.
+  void Expect_(Kind kind) {
+    if (token_.kind != kind) {
+      throw SyntaxError{std::string{"syntax error, unexpected "}
+                        + NameOf_(token_.kind) + ", expecting "
+                        + NameOf_(kind)};
+    }
+    Next_();
+  }
+
+  std::string_view ExpectName_() {
+    const auto name = token_.name;
+    Expect_(Kind::kName);
+    return name;
+  }
+
+  double ExpectNumber_() {
+    const auto number = token_.number;
+    Expect_(Kind::kNumber);
+    return number;
+  }
+
+  /// @return The number of lines from the current position up to the first
+  /// one that starts with a dot, which is an upper bound of the number of
+  /// MOS of the circuit.
+  /// @note Only the newlines are looked for, which `memchr` does a word or a
+  /// vector at a time.
+  std::size_t CountMosLines_() const {
+    auto number_of_lines = std::size_t{0};
+    for (auto* line = next_; line != end_;) {
+      auto* first = line;
+      while (first != end_ && (*first == ' ' || *first == '\t')) {
+        ++first;
+      }
+      if (first != end_ && *first == '.') {
+        break;
+      }
+      ++number_of_lines;
+      const auto* newline = static_cast<const char*>(
+          std::memchr(line, '\n', static_cast<std::size_t>(end_ - line)));
+      line = newline ? newline + 1 : end_;
+    }
+    return number_of_lines;
+  }
+
+  std::shared_ptr<Net> GetOrCreateNet_(std::string_view name) {
+    auto [it, is_new] = nets_.try_emplace(name);
+    if (is_new) {
+      it->second
+          = std::make_shared<Net>(SymbolTable::Instance().Intern(name));
+    }
+    return it->second;
+  }
+
+  Circuit ParseCircuit_() {
+    Expect_(Kind::kSubckt);
+    const auto name = SymbolTable::Instance().Intern(ExpectName_());
+    do {
+      GetOrCreateNet_(ExpectName_());
+    } while (token_.kind == Kind::kName);
+    Expect_(Kind::kEol);
+
+    auto mos = std::vector<std::shared_ptr<Mos>>{};
+    const auto number_of_mos = CountMosLines_();
+    mos.reserve(number_of_mos);
+    nets_.reserve(number_of_mos);
+    do {
+      mos.push_back(ParseMos_());
+      Expect_(Kind::kEol);
+      if (token_.kind != Kind::kEnds && token_.kind != Kind::kName) {
+        throw SyntaxError{std::string{"syntax error, unexpected "}
+                          + NameOf_(token_.kind) + ", expecting ENDS or NAME"};
+      }
+    } while (token_.kind != Kind::kEnds);
+    Next_();
+
+    // The nets of the circuit are kept in the order of their names.
+    auto nets = std::map<std::string_view, std::shared_ptr<Net>>{};
+    for (auto& [_, net] : nets_) {
+      nets.emplace(net->GetName(), std::move(net));
+    }
+    // Nets are not shared across circuits.
+    nets_.clear();
+    return Circuit{std::string{SymbolTable::Instance().NameOf(name)},
+                   std::move(mos), std::move(nets)};
+  }
+
+  std::shared_ptr<Mos> ParseMos_() {
+    // Remove the leading 'M'.
+    const auto name = SymbolTable::Instance().Intern(ExpectName_().substr(1));
+    auto drain = GetOrCreateNet_(ExpectName_());
+    auto gate = GetOrCreateNet_(ExpectName_());
+    auto source = GetOrCreateNet_(ExpectName_());
+    auto substrate = GetOrCreateNet_(ExpectName_());
+    const auto type = token_.type;
+    Expect_(Kind::kMosType);
+    Expect_(Kind::kWidth);
+    Expect_(Kind::kEquals);
+    const auto width = ExpectNumber_();
+    Expect_(Kind::kUnit);
+    Expect_(Kind::kLength);
+    Expect_(Kind::kEquals);
+    const auto length = ExpectNumber_();
+    Expect_(Kind::kUnit);
+    Expect_(Kind::kNfin);
+    Expect_(Kind::kEquals);
+    ExpectNumber_();
+    auto mos = Mos::Create(name, type, std::move(drain), std::move(gate),
+                           std::move(source), std::move(substrate), width,
+                           length);
+    mos->RegisterToConnections();
+    return mos;
+  }
+};
+
+}  // namespace
+
+std::optional<std::vector<Circuit>> euler::ParseMapped(
+    const std::string& file_name) {
+  const auto file = MappedFile{file_name.c_str()};
+  if (!file.IsOpen()) {
+    std::perror(file_name.c_str());
+    return std::nullopt;
+  }
+  auto parser = MappedParser{file.Content()};
+  try {
+    return parser.ParseLibrary();
+  } catch (const SyntaxError& e) {
+    std::cerr << "line " << parser.LineNo() << ": " << e.what() << std::endl;
+    return std::nullopt;
+  }
+}
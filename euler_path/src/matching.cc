@@ -0,0 +1,109 @@
+#include "matching.h"
+
+#include <cstddef>
+#include <limits>
+#include <queue>
+#include <vector>
+
+using namespace euler;
+
+namespace {
+
+constexpr auto kInfinity = std::numeric_limits<std::size_t>::max();
+
+class HopcroftKarp {
+ public:
+  std::vector<std::size_t> Run() {
+    // A greedy matching is usually close to the maximum, which leaves only a
+    // few augmenting paths to find.
+    for (auto left = std::size_t{0}; left < adjacency_.size(); left++) {
+      for (auto right : adjacency_.at(left)) {
+        if (left_of_right_.at(right) == kUnmatched) {
+          Match_(left, right);
+          break;
+        }
+      }
+    }
+    while (Layer_()) {
+      for (auto left = std::size_t{0}; left < adjacency_.size(); left++) {
+        if (right_of_left_.at(left) == kUnmatched) {
+          Augment_(left);
+        }
+      }
+    }
+    return right_of_left_;
+  }
+
+  HopcroftKarp(const std::vector<std::vector<std::size_t>>& adjacency,
+               std::size_t number_of_right)
+      : adjacency_{adjacency},
+        right_of_left_(adjacency.size(), kUnmatched),
+        left_of_right_(number_of_right, kUnmatched),
+        distances_(adjacency.size(), kInfinity) {}
+
+ private:
+  const std::vector<std::vector<std::size_t>>& adjacency_;
+  std::vector<std::size_t> right_of_left_;
+  std::vector<std::size_t> left_of_right_;
+  /// @brief The layer of each left vertex in the alternating BFS.
+  std::vector<std::size_t> distances_;
+
+  void Match_(std::size_t left, std::size_t right) {
+    right_of_left_.at(left) = right;
+    left_of_right_.at(right) = left;
+  }
+
+  /// @brief Layers the left vertices by the length of the shortest
+  /// alternating paths from the unmatched ones.
+  /// @return Whether there's an augmenting path.
+  bool Layer_() {
+    auto queue = std::queue<std::size_t>{};
+    for (auto left = std::size_t{0}; left < adjacency_.size(); left++) {
+      if (right_of_left_.at(left) == kUnmatched) {
+        distances_.at(left) = 0;
+        queue.push(left);
+      } else {
+        distances_.at(left) = kInfinity;
+      }
+    }
+    auto found = false;
+    while (!queue.empty()) {
+      const auto left = queue.front();
+      queue.pop();
+      for (auto right : adjacency_.at(left)) {
+        const auto next = left_of_right_.at(right);
+        if (next == kUnmatched) {
+          found = true;
+        } else if (distances_.at(next) == kInfinity) {
+          distances_.at(next) = distances_.at(left) + 1;
+          queue.push(next);
+        }
+      }
+    }
+    return found;
+  }
+
+  /// @brief Finds an augmenting path along the layers with DFS and flips it.
+  bool Augment_(std::size_t left) {
+    for (auto right : adjacency_.at(left)) {
+      const auto next = left_of_right_.at(right);
+      if (next == kUnmatched
+          || (distances_.at(next) == distances_.at(left) + 1
+              && Augment_(next))) {
+        Match_(left, right);
+        return true;
+      }
+    }
+    // Dead end; no need to visit again in this phase.
+    distances_.at(left) = kInfinity;
+    return false;
+  }
+};
+
+}  // namespace
+
+std::vector<std::size_t> euler::MaximumMatching(
+    const std::vector<std::vector<std::size_t>>& adjacency,
+    std::size_t number_of_right) {
+  return HopcroftKarp{adjacency, number_of_right}.Run();
+}
@@ -3,6 +3,7 @@
 #include <utility>
 
 #include "circuit.h"
+#include "symbol.h"
 
 using namespace euler;
 
@@ -15,20 +16,32 @@ void Mos::RegisterToConnections() {
   substrate_->AddConnection(shared_from_this());
 }
 
-std::shared_ptr<Mos> Mos::Create(std::string name, Type type,
+std::shared_ptr<Mos> Mos::Create(Symbol name, Type type,
                                  std::shared_ptr<Net> drain,
                                  std::shared_ptr<Net> gate,
                                  std::shared_ptr<Net> source,
                                  std::shared_ptr<Net> substrate, double width,
                                  double length) {
-  return std::shared_ptr<Mos>{new Mos{std::move(name), type, drain, gate,
-                                      source, substrate, width, length}};
+  return std::shared_ptr<Mos>{
+      new Mos{name, type, drain, gate, source, substrate, width, length}};
 }
 
-Mos::Mos(std::string name, Type type, std::shared_ptr<Net> drain,
+std::shared_ptr<Mos> Mos::CreateDummy(Type type, std::shared_ptr<Net> drain,
+                                      std::shared_ptr<Net> gate,
+                                      std::shared_ptr<Net> source,
+                                      std::shared_ptr<Net> substrate,
+                                      double width, double length) {
+  static const auto kDummy = SymbolTable::Instance().Intern("Dummy");
+  auto mos = Create(kDummy, type, drain, gate, source, substrate, width,
+                    length);
+  mos->is_dummy_ = true;
+  return mos;
+}
+
+Mos::Mos(Symbol name, Type type, std::shared_ptr<Net> drain,
          std::shared_ptr<Net> gate, std::shared_ptr<Net> source,
          std::shared_ptr<Net> substrate, double width, double length)
-    : name_{std::move(name)},
+    : name_{name},
       type_{type},
       drain_{drain},
       gate_{gate},
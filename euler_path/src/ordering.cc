@@ -0,0 +1,85 @@
+#include "ordering.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "circuit.h"
+#include "mos.h"
+#include "path.h"
+
+using namespace euler;
+
+std::vector<OrientedVertex> euler::OrientationsOf(const Vertex& vertex) {
+  const auto& [p, n] = vertex;
+  return {
+      {vertex,
+       {p->GetDrain(), n->GetDrain()},
+       {p->GetSource(), n->GetSource()}},
+      {vertex,
+       {p->GetSource(), n->GetDrain()},
+       {p->GetDrain(), n->GetSource()}},
+      {vertex,
+       {p->GetDrain(), n->GetSource()},
+       {p->GetSource(), n->GetDrain()}},
+      {vertex,
+       {p->GetSource(), n->GetSource()},
+       {p->GetDrain(), n->GetDrain()}},
+  };
+}
+
+std::vector<Path> euler::ToPaths(const Ordering& ordering) {
+  auto paths = std::vector<Path>{};
+  for (auto i = std::size_t{0}; i < ordering.size(); i++) {
+    auto fragment = std::make_shared<PathFragment>(ordering.at(i).vertex);
+    // Connects to the next vertex with the right side. If this ends up being
+    // the tail, it's a hint of how the vertex is placed, which matters for a
+    // path of a single vertex.
+    fragment->edge_to_next = ordering.at(i).right;
+    if (i == 0 || !CanShare(ordering.at(i - 1), ordering.at(i))) {
+      auto& path = paths.emplace_back();
+      path.head = fragment;
+      path.tail = fragment;
+      continue;
+    }
+    auto& path = paths.back();
+    fragment->prev = path.tail;
+    path.tail->next = fragment;
+    path.tail = fragment;
+  }
+  return paths;
+}
+
+Ordering euler::FromPath(const Path& path) {
+  const auto IsDummy = [](const Vertex& vertex) {
+    return vertex.first->IsDummy();
+  };
+  // The net of the drain or the source, whichever is not `net`.
+  const auto OtherDiffusionOf = [](const Mos& mos,
+                                   const std::shared_ptr<Net>& net) {
+    return mos.GetDrain() == net ? mos.GetSource() : mos.GetDrain();
+  };
+
+  auto ordering = Ordering{};
+  for (auto curr = path.head; curr; curr = curr->next) {
+    if (IsDummy(curr->vertex)) {
+      continue;
+    }
+    const auto& [p, n] = curr->vertex;
+    auto oriented_vertex = OrientedVertex{curr->vertex, {}, {}};
+    if (curr->next) {
+      oriented_vertex.right = curr->edge_to_next;
+      oriented_vertex.left = {OtherDiffusionOf(*p, curr->edge_to_next.first),
+                              OtherDiffusionOf(*n, curr->edge_to_next.second)};
+    } else if (auto prev = curr->prev.lock()) {
+      oriented_vertex.left = prev->edge_to_next;
+      oriented_vertex.right = {OtherDiffusionOf(*p, prev->edge_to_next.first),
+                               OtherDiffusionOf(*n, prev->edge_to_next.second)};
+    } else {
+      // A single vertex can be placed in any way.
+      oriented_vertex = OrientationsOf(curr->vertex).front();
+    }
+    ordering.push_back(std::move(oriented_vertex));
+  }
+  return ordering;
+}
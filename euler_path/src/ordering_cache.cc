@@ -0,0 +1,228 @@
+#include "ordering_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "canonical_form.h"
+#include "circuit.h"
+#include "mos.h"
+
+using namespace euler;
+
+namespace {
+
+/// @note The fields of `OrderingCache::Entry`.
+constexpr auto kNumberOfIndicesPerEntry = std::size_t{6};
+
+}  // namespace
+
+Ordering OrderingCache::FindOrSolve(const CanonicalForm& form,
+                                    const std::function<Ordering()>& solve) {
+  auto promise = std::promise<CanonicalOrdering>{};
+  const auto key = std::pair{settings_, form.certificate};
+  for (;;) {
+    auto cached = std::shared_future<CanonicalOrdering>{};
+    {
+      auto lock = std::lock_guard{mutex_};
+      if (auto it = orderings_.find(key); it != orderings_.end()) {
+        cached = it->second;
+      } else {
+        orderings_.emplace(key, promise.get_future().share());
+        break;
+      }
+    }
+
+    const auto& canonical_ordering = cached.get();
+    auto ordering = Ordering{};
+    for (const auto& entry : canonical_ordering) {
+      ordering.push_back({{form.mos.at(entry.p), form.mos.at(entry.n)},
+                          {form.nets.at(entry.left_p),
+                           form.nets.at(entry.left_n)},
+                          {form.nets.at(entry.right_p),
+                           form.nets.at(entry.right_n)}});
+    }
+    if (Fits_(ordering, canonical_ordering)) {
+      return ordering;
+    }
+
+    // Drop the entry to solve again, unless another lookup has already
+    // replaced it. The futures share the state if they give the same object.
+    auto lock = std::lock_guard{mutex_};
+    if (auto it = orderings_.find(key);
+        it != orderings_.end()
+        && it->second.wait_for(std::chrono::seconds{0})
+               == std::future_status::ready) {
+      try {
+        if (&it->second.get() == &canonical_ordering) {
+          orderings_.erase(it);
+        }
+      } catch (...) {
+        // Failed to solve, so not the entry.
+      }
+    }
+  }
+
+  try {
+    auto ordering = solve();
+    auto index_of_mos = std::map<const Mos*, std::size_t>{};
+    for (auto i = std::size_t{0}; i < form.mos.size(); i++) {
+      index_of_mos.emplace(form.mos.at(i).get(), i);
+    }
+    auto index_of_nets = std::map<const Net*, std::size_t>{};
+    for (auto i = std::size_t{0}; i < form.nets.size(); i++) {
+      index_of_nets.emplace(form.nets.at(i).get(), i);
+    }
+    auto canonical_ordering = CanonicalOrdering{};
+    for (const auto& [vertex, left, right] : ordering) {
+      canonical_ordering.push_back({index_of_mos.at(vertex.first.get()),
+                                    index_of_mos.at(vertex.second.get()),
+                                    index_of_nets.at(left.first.get()),
+                                    index_of_nets.at(left.second.get()),
+                                    index_of_nets.at(right.first.get()),
+                                    index_of_nets.at(right.second.get())});
+    }
+    promise.set_value(std::move(canonical_ordering));
+    return ordering;
+  } catch (...) {
+    // Those waiting on the circuit get the same error.
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+}
+
+bool OrderingCache::Fits_(const Ordering& ordering,
+                          const CanonicalOrdering& canonical_ordering) {
+  const auto HasSides = [](const Mos& mos, const std::shared_ptr<Net>& left,
+                           const std::shared_ptr<Net>& right) {
+    return (left == mos.GetDrain() && right == mos.GetSource())
+           || (left == mos.GetSource() && right == mos.GetDrain());
+  };
+  for (auto i = std::size_t{0}; i < ordering.size(); i++) {
+    const auto& [vertex, left, right] = ordering.at(i);
+    const auto& [p, n] = vertex;
+    if (p->GetType() != Mos::Type::kP || n->GetType() != Mos::Type::kN
+        || p->GetGate() != n->GetGate()
+        || !HasSides(*p, left.first, right.first)
+        || !HasSides(*n, left.second, right.second)) {
+      return false;
+    }
+    if (i + 1 == ordering.size()) {
+      continue;
+    }
+    const auto& entry = canonical_ordering.at(i);
+    const auto& next = canonical_ordering.at(i + 1);
+    if (CanShare(ordering.at(i), ordering.at(i + 1))
+        != (entry.right_p == next.left_p && entry.right_n == next.left_n)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void OrderingCache::Load(std::istream& in) {
+  auto line = std::string{};
+  while (std::getline(in, line)) {
+    // <settings>\t<certificate>\t<p> <n> <left p> <left n> <right p>
+    // <right n> ...
+    const auto settings_tab = line.find('\t');
+    if (settings_tab == std::string::npos) {
+      continue;
+    }
+    auto settings = line.substr(0, settings_tab);
+    const auto tab = line.find('\t', settings_tab + 1);
+    if (tab == std::string::npos) {
+      continue;
+    }
+    auto certificate = line.substr(settings_tab + 1, tab - settings_tab - 1);
+    // The certificate starts with the number of MOS and nets.
+    auto number_of_mos = std::size_t{0};
+    auto number_of_nets = std::size_t{0};
+    if (!(std::istringstream{certificate} >> number_of_mos >> number_of_nets)) {
+      continue;
+    }
+    auto indices = std::vector<std::size_t>{};
+    auto entries = std::istringstream{line.substr(tab + 1)};
+    for (auto index = std::size_t{0}; entries >> index;) {
+      indices.push_back(index);
+    }
+    if (!entries.eof() || indices.size() % kNumberOfIndicesPerEntry) {
+      continue;
+    }
+    auto canonical_ordering = CanonicalOrdering{};
+    for (auto i = std::size_t{0}; i < indices.size();
+         i += kNumberOfIndicesPerEntry) {
+      canonical_ordering.push_back({indices.at(i), indices.at(i + 1),
+                                    indices.at(i + 2), indices.at(i + 3),
+                                    indices.at(i + 4), indices.at(i + 5)});
+    }
+    const auto IsInRange = [number_of_mos, number_of_nets](const Entry& e) {
+      return e.p < number_of_mos && e.n < number_of_mos
+             && e.left_p < number_of_nets && e.left_n < number_of_nets
+             && e.right_p < number_of_nets && e.right_n < number_of_nets;
+    };
+    if (!std::all_of(canonical_ordering.begin(), canonical_ordering.end(),
+                     IsInRange)) {
+      continue;
+    }
+    // Each MOS is placed exactly once.
+    auto is_placed = std::vector<bool>(number_of_mos);
+    auto number_of_placed = std::size_t{0};
+    for (const auto& entry : canonical_ordering) {
+      for (auto mos : {entry.p, entry.n}) {
+        if (!is_placed.at(mos)) {
+          is_placed.at(mos) = true;
+          ++number_of_placed;
+        }
+      }
+    }
+    if (number_of_placed != number_of_mos
+        || 2 * canonical_ordering.size() != number_of_mos) {
+      continue;
+    }
+    auto promise = std::promise<CanonicalOrdering>{};
+    promise.set_value(std::move(canonical_ordering));
+    auto lock = std::lock_guard{mutex_};
+    orderings_.emplace(std::pair{std::move(settings), std::move(certificate)},
+                       promise.get_future().share());
+  }
+}
+
+void OrderingCache::Save(std::ostream& out) const {
+  auto lock = std::lock_guard{mutex_};
+  for (const auto& [key, ordering] : orderings_) {
+    // Those still being solved or failed are left out.
+    if (ordering.wait_for(std::chrono::seconds{0})
+        != std::future_status::ready) {
+      continue;
+    }
+    const CanonicalOrdering* entries = nullptr;
+    try {
+      entries = &ordering.get();
+    } catch (...) {
+      continue;
+    }
+    const auto& [settings, certificate] = key;
+    out << settings << '\t' << certificate << '\t';
+    auto is_first = true;
+    for (const auto& entry : *entries) {
+      out << (is_first ? "" : " ") << entry.p << ' ' << entry.n << ' '
+          << entry.left_p << ' ' << entry.left_n << ' ' << entry.right_p
+          << ' ' << entry.right_n;
+      is_first = false;
+    }
+    out << '\n';
+  }
+}
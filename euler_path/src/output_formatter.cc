@@ -0,0 +1,61 @@
+#include "output_formatter.h"
+
+#include <cstdio>
+#include <string>
+
+#include "circuit.h"
+#include "mos.h"
+
+using namespace euler;
+
+void OutputFormatter::Out() {
+  // The first line gives the total HPWL of all nets in the SPICE netlist.
+  // Formatted the same as an output stream does by default.
+  char hpwl[32];
+  std::snprintf(hpwl, sizeof(hpwl), "%g", hpwl_);
+  out_ += hpwl;
+  out_ += '\n';
+  // A run of dummies is written as a single one.
+  // The second and third lines shows the Euler path of the PMOS network in
+  // terms of instance names and net names, respectively.
+  const auto* prev_p_mos = path_.head->vertex.first.get();
+  for (auto curr = path_.head; curr; curr = curr->next) {
+    const auto* p = curr->vertex.first.get();
+    if (!p->IsDummy() || !prev_p_mos->IsDummy()) {
+      out_ += p->GetName();
+      out_ += ' ';
+    }
+    prev_p_mos = p;
+  }
+  out_ += '\n';
+  const auto* prev_p_net = edges_.front().first.get();
+  for (const auto& [p, _] : edges_) {
+    if (!p->IsDummy() || !prev_p_net->IsDummy()) {
+      out_ += p->GetName();
+      out_ += ' ';
+    }
+    prev_p_net = p.get();
+  }
+  out_ += '\n';
+  // The fourth and fifth lines shows the Euler path of the NMOS network in
+  // terms of instance names and net names, respectively.
+  const auto* prev_n_mos = path_.head->vertex.second.get();
+  for (auto curr = path_.head; curr; curr = curr->next) {
+    const auto* n = curr->vertex.second.get();
+    if (!n->IsDummy() || !prev_n_mos->IsDummy()) {
+      out_ += n->GetName();
+      out_ += ' ';
+    }
+    prev_n_mos = n;
+  }
+  out_ += '\n';
+  const auto* prev_n_net = edges_.front().second.get();
+  for (const auto& [_, n] : edges_) {
+    if (!n->IsDummy() || !prev_n_net->IsDummy()) {
+      out_ += n->GetName();
+      out_ += ' ';
+    }
+    prev_n_net = n.get();
+  }
+  // No end-of-file newline.
+}
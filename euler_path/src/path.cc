@@ -1,5 +1,8 @@
 #include "path.h"
 
+#include <memory>
+#include <utility>
+
 #ifdef DEBUG
 #include <iostream>
 
@@ -35,6 +38,22 @@ Path& Path::operator=(const Path& other) {
   return *this;
 }
 
+void Reverse(Path& path) {
+  auto prev = std::shared_ptr<PathFragment>{};
+  auto edge = Edge{};
+  for (auto curr = path.head; curr;) {
+    auto next = curr->next;
+    auto next_edge = curr->edge_to_next;
+    curr->next = prev;
+    curr->edge_to_next = edge;
+    curr->prev = next;
+    prev = curr;
+    edge = next_edge;
+    curr = next;
+  }
+  std::swap(path.head, path.tail);
+}
+
 #ifdef DEBUG
 void PrintPath(const Path& path) {
   for (auto curr = path.head; curr; curr = curr->next) {
@@ -1,17 +1,35 @@
 #include "path_finder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <future>
+#include <initializer_list>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <optional>
+#include <random>
 #include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "canonical_form.h"
 #include "circuit.h"
+#include "design_rule.h"
+#include "euler_trail_solver.h"
+#include "exact_solver.h"
+#include "local_search.h"
+#include "matching.h"
 #include "mos.h"
+#include "ordering.h"
+#include "ordering_cache.h"
 #include "path.h"
+#include "path_finder_stats.h"
+#include "thread_pool.h"
 
 #ifdef DEBUG
 #include <string>
@@ -54,6 +72,28 @@ struct FreeNets {
 /// @return The free nets of the `fragment`, which can be used to connect to the
 /// next neighbor.
 FreeNets FindFreeNets(const PathFragment& fragment);
+/// @return The free nets of an end vertex whose only connection is `edge`.
+FreeNets FindFreeNets(const Vertex& vertex, const Edge& edge);
+
+/// @return The edge that connects the free nets to the diffusions of
+/// `neighbor`, if any.
+std::optional<Edge> EdgeTo(const FreeNets& free_nets, const Vertex& neighbor);
+
+/// @brief Rotates the path in place, so that `new_head` becomes the head.
+/// The connection between `new_head` and its next is taken by the head, and
+/// the part from the head to `new_head` is reversed.
+/// @note The head has to be able to take the connection.
+void RotateHead(Path& path, const std::shared_ptr<PathFragment>& new_head);
+
+/// @brief Moves `net` to the front of `nets`, if it's in there.
+void PreferFront(std::vector<std::shared_ptr<Net>>& nets,
+                 const std::shared_ptr<Net>& net);
+/// @brief Moves `net` to the back of `nets`, if it's in there.
+void PreferBack(std::vector<std::shared_ptr<Net>>& nets,
+                const std::shared_ptr<Net>& net);
+
+bool HasNet(const std::vector<std::shared_ptr<Net>>& nets,
+            const std::shared_ptr<Net>& net);
 
 /// @return The nets that connect the MOS in the Hamilton path, including the
 /// gate connections of the MOS.
@@ -67,24 +107,133 @@ std::vector<std::shared_ptr<Net>> NetsOf(const Mos&);
 
 }  // namespace
 
+struct PathFinder::Candidate {
+  Path path;
+  std::size_t number_of_dummies;
+  double hpwl;
+};
+
 std::tuple<Path, std::vector<Edge>, double> PathFinder::FindPath() {
-  GroupVertices_();
-  BuildGraph_();
+  auto timer = ScopedTimer{stats_.total};
+  deadline_ = std::chrono::steady_clock::now() + option_.time_limit;
+  auto candidate = std::optional<Candidate>{};
+  if (!option_.cache) {
+    candidate = Solve_();
+  } else {
+    auto form = CanonicalForm{};
+    {
+      auto timer = ScopedTimer{stats_.canonical_form};
+      form = CanonicalFormOf(circuit_);
+    }
+    auto ordering
+        = option_.cache->FindOrSolve(form, [this, &candidate]() {
+            candidate = Solve_();
+            return FromPath(candidate->path);
+          });
+    // Not solved, so it's an isomorphic circuit that is cached.
+    if (!candidate) {
+      stats_.is_cache_hit = true;
+      candidate = MakeCandidate_(ToPaths(ordering));
+    }
+  }
+  stats_.dummies = candidate->number_of_dummies;
+#ifdef DEBUG
+  std::cerr << "=== Dummies: " << candidate->number_of_dummies << " ==="
+            << std::endl;
+  PrintPath(candidate->path);
+#endif
+  auto edges = GetEdgesOf(candidate->path);
+  return {std::move(candidate->path), std::move(edges), candidate->hpwl};
+}
+
+PathFinder::Candidate PathFinder::Solve_() {
+  {
+    auto timer = ScopedTimer{stats_.group_vertices};
+    GroupVertices_();
+  }
+
+  // Small cells are solved exactly; the heuristic is for the larger ones.
+  // Only the Hamiltonian paths need the graph of the pairs.
+  auto candidate = std::optional<Candidate>{};
+  if (vertices_.size() <= option_.exact_limit) {
+    {
+      auto timer = ScopedTimer{stats_.exact_solver};
+      candidate = FindOptimalPaths_();
+    }
+    // Out of time while filling the table. The Euler trails still chain the
+    // pairs in linear time.
+    if (!candidate) {
+      auto timer = ScopedTimer{stats_.heuristic};
+      return FindEulerTrails_();
+    }
+  } else if (option_.engine == Engine::kEulerTrail) {
+    auto timer = ScopedTimer{stats_.heuristic};
+    candidate = FindEulerTrails_();
+  } else {
+    {
+      auto timer = ScopedTimer{stats_.build_graph};
+      BuildGraph_();
+    }
+    // Out of time while building the graph, which is then incomplete. The
+    // Euler trails still chain the pairs in linear time.
+    if (IsTimeUp_()) {
+      auto timer = ScopedTimer{stats_.heuristic};
+      return FindEulerTrails_();
+    }
 
 #ifdef DEBUG
-  std::cerr << "=== Graph ===" << std::endl;
-  for (const auto& vertex : vertices_) {
-    std::cerr << vertex.first->GetName() << " " << vertex.second->GetName()
-              << std::endl;
-    for (const auto& neighbor : adjacency_list_.at(vertex)) {
-      std::cerr << "  " << neighbor.first->GetName() << " "
-                << neighbor.second->GetName() << std::endl;
+    std::cerr << "=== Graph ===" << std::endl;
+    for (const auto& vertex : vertices_) {
+      std::cerr << vertex.first->GetName() << " "
+                << vertex.second->GetName() << std::endl;
+      for (const auto& neighbor : adjacency_list_.at(vertex)) {
+        std::cerr << "  " << neighbor.first->GetName() << " "
+                  << neighbor.second->GetName() << std::endl;
+      }
     }
-  }
 #endif
 
-  auto paths = FindHamiltonPaths_();
+    auto timer = ScopedTimer{stats_.heuristic};
+    candidate = FindHamiltonPathsWithMultiStart_();
+  }
+  if (option_.local_search_moves && !IsTimeUp_()) {
+    auto timer = ScopedTimer{stats_.local_search};
+    candidate = ImproveHpwl_(std::move(*candidate));
+  }
+  return std::move(*candidate);
+}
 
+PathFinder::Candidate PathFinder::ImproveHpwl_(Candidate candidate) const {
+  auto nets = std::vector<std::shared_ptr<Net>>{};
+  for (const auto& [_, net] : circuit_.nets) {
+    nets.push_back(net);
+  }
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  if (option_.local_search_budget.count()) {
+    deadline = std::chrono::steady_clock::now() + option_.local_search_budget;
+  }
+  if (option_.time_limit.count()) {
+    deadline = std::min(deadline, deadline_);
+  }
+  auto local_search = LocalSearch{FromPath(candidate.path), nets,
+                                  option_.local_search_moves, deadline};
+  auto improved = MakeCandidate_(ToPaths(local_search.Run()));
+  // Only the time limit counts as a hit, not the budgets of the local search.
+  if (local_search.IsCutShort()) {
+    IsTimeUp_();
+  }
+  // The local search keeps the number of breaks and works on the same HPWL,
+  // but the path is re-derived from the edges; take it only if it's indeed
+  // better.
+  if (std::tie(improved.number_of_dummies, improved.hpwl)
+      < std::tie(candidate.number_of_dummies, candidate.hpwl)) {
+    return improved;
+  }
+  return candidate;
+}
+
+PathFinder::Candidate PathFinder::MakeCandidate_(
+    const std::vector<Path>& paths) const {
 #ifdef DEBUG
   std::cerr << "=== Paths ===" << std::endl;
   for (const auto& path : paths) {
@@ -96,79 +245,245 @@ std::tuple<Path, std::vector<Edge>, double> PathFinder::FindPath() {
   }
 #endif
 
-  auto path = ConnectHamiltonPathOfSubgraphsWithDummy(paths);
+  auto path = ConnectWithDummies_(paths);
+  auto hpwl = CalculateHpwl_(path);
+  // Each connection between two paths takes a pair of dummies.
+  return {std::move(path), 2 * (paths.size() - 1), hpwl};
+}
+
+Path PathFinder::ConnectWithDummies_(const std::vector<Path>& paths) const {
+  return ConnectHamiltonPathOfSubgraphsWithDummy(paths);
+}
+
+PathFinder::Candidate PathFinder::FindEulerTrails_() const {
+  auto euler_trail_solver = EulerTrailSolver{vertices_};
+  return MakeCandidate_(ToPaths(euler_trail_solver.Solve()));
+}
+
+std::optional<PathFinder::Candidate> PathFinder::FindOptimalPaths_() const {
+  auto exact_solver = ExactSolver{vertices_, option_.number_of_threads};
+  const auto orderings
+      = exact_solver.Solve(option_.time_limit.count()
+                               ? deadline_
+                               : std::chrono::steady_clock::time_point::max());
+  if (orderings.empty()) {
+    IsTimeUp_();
+    return std::nullopt;
+  }
+  auto best = std::optional<Candidate>{};
+  // All orderings have the minimum number of breaks; the HPWL decides.
+  for (const auto& ordering : orderings) {
+    auto candidate = MakeCandidate_(ToPaths(ordering));
+    if (!best || candidate.hpwl < best->hpwl) {
+      best = std::move(candidate);
+    }
+  }
+  return best;
+}
+
+std::vector<Vertex> PathFinder::SortedVertices_() const {
+  auto index_of_mos = std::unordered_map<const Mos*, std::size_t>{};
+  for (const auto& mos : circuit_.mos) {
+    index_of_mos.emplace(mos.get(), index_of_mos.size());
+  }
+  auto sorted_vertices = vertices_;
+  std::sort(sorted_vertices.begin(), sorted_vertices.end(),
+            [&index_of_mos](const Vertex& a, const Vertex& b) {
+              return index_of_mos.at(a.first.get())
+                     < index_of_mos.at(b.first.get());
+            });
+  return sorted_vertices;
+}
+
+PathFinder::Candidate PathFinder::FindHamiltonPathsWithMultiStart_() const {
+  // The deterministic search starts from the vertices in the netlist order.
+  // The shuffles below also start from it, not from the addresses of the
+  // MOS, which differ between the front ends.
+  const auto sorted_vertices = SortedVertices_();
+
+  const auto Search = [this, &sorted_vertices](unsigned start) {
+    if (start == 0) {
+      return MakeCandidate_(
+          FindHamiltonPaths_(adjacency_list_, sorted_vertices));
+    }
+    auto rng = std::mt19937{option_.seed + start};
+    auto start_order = sorted_vertices;
+    std::shuffle(start_order.begin(), start_order.end(), rng);
+    auto graph = adjacency_list_;
+    for (const auto& vertex : sorted_vertices) {
+      auto& neighbors = graph.at(vertex);
+      std::shuffle(neighbors.begin(), neighbors.end(), rng);
+    }
+    return MakeCandidate_(FindHamiltonPaths_(graph, start_order));
+  };
+
+  auto number_of_starts = option_.number_of_starts;
+  const auto has_time_budget = option_.time_budget.count() != 0;
+  if (number_of_starts == 0 && !has_time_budget) {
+    number_of_starts = 1;
+  }
+  if (number_of_starts == 1) {
+    return Search(0);
+  }
+
+  using IndexedCandidate = std::pair<unsigned /* start */, Candidate>;
+  // Ties are broken by the index of the start, so that the result doesn't
+  // depend on the scheduling of the threads.
+  const auto IsBetter = [](const IndexedCandidate& a,
+                           const IndexedCandidate& b) {
+    return std::tie(a.second.number_of_dummies, a.second.hpwl, a.first)
+           < std::tie(b.second.number_of_dummies, b.second.hpwl, b.first);
+  };
+  const auto deadline
+      = std::chrono::steady_clock::now() + option_.time_budget;
+  auto next_start = std::atomic<unsigned>{0};
+  const auto Work = [&]() {
+    auto best = std::optional<IndexedCandidate>{};
+    while (true) {
+      auto start = next_start++;
+      if (number_of_starts != 0 && start >= number_of_starts) {
+        break;
+      }
+      // The deterministic start always runs, so there's at least one
+      // candidate.
+      if (start != 0
+          && ((has_time_budget
+               && std::chrono::steady_clock::now() >= deadline)
+              || IsTimeUp_())) {
+        break;
+      }
+      auto candidate = IndexedCandidate{start, Search(start)};
+      if (!best || IsBetter(candidate, *best)) {
+        best = std::move(candidate);
+      }
+    }
+    return best;
+  };
+
+  auto number_of_threads = option_.number_of_threads;
+  if (number_of_starts != 0) {
+    number_of_threads = std::min(number_of_threads, number_of_starts);
+  }
+  auto thread_pool = ThreadPool{number_of_threads};
+  auto results = std::vector<std::future<std::optional<IndexedCandidate>>>{};
+  for (auto i = std::size_t{0}; i < thread_pool.Size(); i++) {
+    results.push_back(thread_pool.Submit(Work));
+  }
+  auto best = std::optional<IndexedCandidate>{};
+  for (auto& result : results) {
+    if (auto candidate = result.get();
+        candidate && (!best || IsBetter(*candidate, *best))) {
+      best = std::move(candidate);
+    }
+  }
+  assert(best && "the deterministic start always runs");
 #ifdef DEBUG
-  PrintPath(path);
+  std::cerr << "=== Best start: " << best->first << " of " << next_start - 1
+            << " ===" << std::endl;
 #endif
-  return {path, GetEdgesOf(path), CalculateHpwl_(path)};
+  return std::move(best->second);
 }
 
 void PathFinder::GroupVertices_() {
+  // The nets are indexed by integer ids, in the order of their names.
+  auto id_of_nets = std::unordered_map<const Net*, std::size_t>{};
+  for (const auto& [_, net] : circuit_.nets) {
+    id_of_nets.emplace(net.get(), id_of_nets.size());
+  }
+  const auto IdOf = [&id_of_nets](const std::shared_ptr<Net>& net) {
+    return id_of_nets.at(net.get());
+  };
+
   // Separate the P MOS transistors from the N MOS transistors.
-  auto p_mos = std::map<std::shared_ptr<Net> /* gate */,
-                        std::vector<std::shared_ptr<Mos>>>{};
-  auto n_mos = std::map<std::shared_ptr<Net> /* gate */,
-                        std::vector<std::shared_ptr<Mos>>>{};
-  for (const auto& mos : circuit_->mos) {
+  auto p_mos_of_gates
+      = std::vector<std::vector<std::shared_ptr<Mos>>>(id_of_nets.size());
+  auto n_mos_of_gates
+      = std::vector<std::vector<std::shared_ptr<Mos>>>(id_of_nets.size());
+  for (const auto& mos : circuit_.mos) {
     if (mos->GetType() == Mos::Type::kP) {
-      p_mos[mos->GetGate()].push_back(mos);
+      p_mos_of_gates.at(IdOf(mos->GetGate())).push_back(mos);
     } else {
-      n_mos[mos->GetGate()].push_back(mos);
+      n_mos_of_gates.at(IdOf(mos->GetGate())).push_back(mos);
     }
   }
 
-  // Group the P MOS transistors with the N MOS transistors.
-  for (const auto& [gate, p_mos_with_same_gate] : p_mos) {
-    assert(n_mos.find(gate) != n_mos.end()
-           && "A P MOS should at least have a corresponding N MOS.");
-    const auto& n_mos_with_same_gate = n_mos.at(gate);
+  // Group the P MOS transistors with the N MOS transistors of the same gate.
+  // The N MOS are indexed by the nets of their drains and sources, to find
+  // those sharing a diffusion net without trying every pair.
+  auto n_mos_of_nets
+      = std::unordered_map<std::size_t, std::vector<std::size_t>>{};
+  for (auto gate = std::size_t{0}; gate < id_of_nets.size(); gate++) {
+    const auto& p_mos = p_mos_of_gates.at(gate);
+    const auto& n_mos = n_mos_of_gates.at(gate);
+    assert(p_mos.size() == n_mos.size()
+           && "A P MOS should have a corresponding N MOS, and vice versa.");
+    if (p_mos.empty()) {
+      continue;
+    }
     // If there is only one P MOS transistor, then it is paired with the
     // corresponding N MOS transistor.
-    if (p_mos_with_same_gate.size() == 1) {
-      assert(n_mos_with_same_gate.size() == 1
-             && "An N MOS should at least have a corresponding P MOS.");
-      vertices_.emplace_back(p_mos_with_same_gate.front(),
-                             n_mos_with_same_gate.front());
+    if (p_mos.size() == 1) {
+      vertices_.emplace_back(p_mos.front(), n_mos.front());
       continue;
     }
 
-    auto remaining_n_mos = n_mos_with_same_gate;
-    auto remaining_p_mos = p_mos_with_same_gate;
-    // If the P MOS transistor and the N MOS transistor share another
-    // common connection, then they are paired.
-    for (const auto& n : n_mos_with_same_gate) {
-      for (const auto& p : p_mos_with_same_gate) {
-        // NOTE: The connection of substrate doesn't count since all P MOS
-        // usually all connect their substrate to the same point. So are the N
-        // MOS.
-        if (p->GetDrain() == n->GetDrain()
-            || p->GetSource() == n->GetSource()) {
-          vertices_.emplace_back(p, n);
-          remaining_p_mos.erase(
-              std::find_if(remaining_p_mos.begin(), remaining_p_mos.end(),
-                           [&p](const auto& p_) { return p_ == p; }));
-          remaining_n_mos.erase(
-              std::find_if(remaining_n_mos.begin(), remaining_n_mos.end(),
-                           [&n](const auto& n_) { return n_ == n; }));
+    // A P MOS and an N MOS are better paired if they share another common
+    // connection, so that their diffusions line up. The pairs sharing both
+    // the drain and the source come first, which the matching prefers.
+    // NOTE: The connection of substrate doesn't count since all P MOS usually
+    // all connect their substrate to the same point. So are the N MOS.
+    n_mos_of_nets.clear();
+    for (auto j = std::size_t{0}; j < n_mos.size(); j++) {
+      n_mos_of_nets[IdOf(n_mos.at(j)->GetDrain())].push_back(j);
+      if (n_mos.at(j)->GetSource() != n_mos.at(j)->GetDrain()) {
+        n_mos_of_nets[IdOf(n_mos.at(j)->GetSource())].push_back(j);
+      }
+    }
+    auto adjacency = std::vector<std::vector<std::size_t>>(p_mos.size());
+    for (auto i = std::size_t{0}; i < p_mos.size(); i++) {
+      const auto& p = p_mos.at(i);
+      auto lined_up = std::vector<std::size_t>{};
+      auto half_lined_up = std::vector<std::size_t>{};
+      for (const auto& net : {p->GetDrain(), p->GetSource()}) {
+        if (auto it = n_mos_of_nets.find(IdOf(net));
+            it != n_mos_of_nets.end()) {
+          half_lined_up.insert(half_lined_up.end(), it->second.begin(),
+                               it->second.end());
+        }
+        if (p->GetSource() == p->GetDrain()) {
           break;
         }
       }
+      // Those found through both nets line up on both sides.
+      std::sort(half_lined_up.begin(), half_lined_up.end());
+      for (auto it = half_lined_up.begin(); it != half_lined_up.end();) {
+        auto next = std::upper_bound(it, half_lined_up.end(), *it);
+        (next - it > 1 ? lined_up : adjacency.at(i)).push_back(*it);
+        it = next;
+      }
+      adjacency.at(i).insert(adjacency.at(i).begin(), lined_up.begin(),
+                             lined_up.end());
     }
-
-#ifdef DEBUG
-    for (const auto& p : remaining_p_mos) {
-      std::cerr << "Remaining P MOS: " << p->GetName() << std::endl;
-    }
-    for (const auto& n : remaining_n_mos) {
-      std::cerr << "Remaining N MOS: " << n->GetName() << std::endl;
-    }
-#endif
+    auto n_of_p = MaximumMatching(adjacency, n_mos.size());
 
     // While sometime multiple P and N MOS share only the gate. In such case, we
-    // can pair them in any way.
-    assert(remaining_n_mos.size() == remaining_p_mos.size());
-    for (auto i = std::size_t{0}; i < remaining_n_mos.size(); i++) {
-      vertices_.emplace_back(remaining_p_mos.at(i), remaining_n_mos.at(i));
+    // can pair the rest in any way.
+    auto is_n_paired = std::vector<bool>(n_mos.size());
+    for (auto n : n_of_p) {
+      if (n != kUnmatched) {
+        is_n_paired.at(n) = true;
+      }
+    }
+    auto next_n = std::size_t{0};
+    for (auto i = std::size_t{0}; i < p_mos.size(); i++) {
+      if (n_of_p.at(i) == kUnmatched) {
+        while (is_n_paired.at(next_n)) {
+          ++next_n;
+        }
+        is_n_paired.at(next_n) = true;
+        n_of_p.at(i) = next_n;
+      }
+      vertices_.emplace_back(p_mos.at(i), n_mos.at(n_of_p.at(i)));
     }
   }
 
@@ -184,6 +499,9 @@ void PathFinder::BuildGraph_() {
   // Each pair is a vertex in the graph. Two vertex are neighbors if they have
   // their P MOS connected and N MOS connected.
   for (const auto& v : vertices_) {
+    if (IsTimeUp_()) {
+      return;
+    }
     adjacency_list_[v] = Neighbors{};
     for (const auto& v_ : vertices_) {
       if (v == v_) {
@@ -196,37 +514,51 @@ void PathFinder::BuildGraph_() {
   }
 }
 
-std::vector<Path> PathFinder::FindHamiltonPaths_() {
+std::vector<Path> PathFinder::FindHamiltonPaths_(
+    const Graph& graph, const std::vector<Vertex>& start_order) const {
   // Select from the to visited list should be faster than iterating through all
   // the vertices and checking whether they are in the visited list.
+  ++stats_.starts;
   auto to_visit = std::set<Vertex>{vertices_.cbegin(), vertices_.cend()};
   auto paths = std::vector<Path>{};
+  auto next_start = start_order.cbegin();
   while (!to_visit.empty()) {
-    // Randomly select a vertex to start. We select the first one for
-    // simplicity.
+    // Vertices before the next start are all visited, so we never have to look
+    // back.
+    while (to_visit.find(*next_start) == to_visit.cend()) {
+      ++next_start;
+    }
     auto path = Path{};
-    path.head = std::make_shared<PathFragment>(*to_visit.begin());
+    path.head = std::make_shared<PathFragment>(*next_start);
     path.tail = path.head;
-    to_visit.erase(to_visit.begin());
+    to_visit.erase(*next_start);
 
     // Find a Hamilton path.
     while (true) {
-      if (auto extended_path = Extend_(path, to_visit); extended_path) {
-        path = std::move(*extended_path);
+      // Out of time, the path is closed off as it is, and the rest of the
+      // vertices are chained by the Euler trails, which takes linear time.
+      if (IsTimeUp_()) {
+        paths.push_back(std::move(path));
+        auto rest = std::vector<Vertex>{};
+        for (const auto& vertex : start_order) {
+          if (to_visit.find(vertex) != to_visit.cend()) {
+            rest.push_back(vertex);
+          }
+        }
+        for (auto& trail : ToPaths(EulerTrailSolver{rest}.Solve())) {
+          paths.push_back(std::move(trail));
+        }
+        to_visit.clear();
+        break;
+      }
+      if (Extend_(path, to_visit, graph)) {
         continue;
       }
 
       // Can no longer extend. Try to rotate the path.
-      auto found = false;
-      for (const auto& rotated_path : Rotate_(path)) {
-        if (auto extended_path = Extend_(rotated_path, to_visit);
-            extended_path) {
-          path = std::move(*extended_path);
-          found = true;
-          break;
-        }
-      }
-      if (found) {
+      auto endpoints = std::set<Vertex>{path.head->vertex, path.tail->vertex};
+      if (RotateAndExtend_(path, to_visit, graph, option_.rotation_depth,
+                           endpoints)) {
         continue;
       }
 
@@ -235,16 +567,17 @@ std::vector<Path> PathFinder::FindHamiltonPaths_() {
       break;
     }
   }
+  stats_.sub_paths += paths.size();
   return paths;
 }
 
-std::optional<Path> PathFinder::Extend_(Path path,
-                                        std::set<Vertex>& to_visit) const {
+bool PathFinder::Extend_(Path& path, std::set<Vertex>& to_visit,
+                         const Graph& graph) const {
   // If the neighbor of the start or end vertex is not in the path, then we add
   // it into the path.
   // NOTE: If a net is already used in a connection, we cannot uses it
   // again.
-  for (const auto& neighbor : adjacency_list_.at(path.tail->vertex)) {
+  for (const auto& neighbor : graph.at(path.tail->vertex)) {
     if (to_visit.find(neighbor) != to_visit.cend()) {
 #ifdef DEBUG
       std::cerr << "Extend " << path.tail->vertex.first->GetName() << " "
@@ -253,32 +586,19 @@ std::optional<Path> PathFinder::Extend_(Path path,
                 << neighbor.second->GetName() << "...";
 #endif
 
-      auto edge = Edge{};
-      auto free_nets = FindFreeNets(*path.tail);
-      for (auto free_net : free_nets.p) {
-        if (free_net == neighbor.first->GetSource()
-            || free_net == neighbor.first->GetDrain()) {
-          edge.first = free_net;
-          break;
-        }
-      }
-      for (auto free_net : free_nets.n) {
-        if (free_net == neighbor.second->GetSource()
-            || free_net == neighbor.second->GetDrain()) {
-          edge.second = free_net;
-          break;
-        }
-      }
-      if (edge.first && edge.second) {
+      ++stats_.tail_extension_attempts;
+      ++stats_.free_net_computations;
+      if (auto edge = EdgeTo(FindFreeNets(*path.tail), neighbor); edge) {
         path.tail->next = std::make_shared<PathFragment>(neighbor, path.tail);
-        path.tail->edge_to_next = edge;
+        path.tail->edge_to_next = *edge;
         path.tail = path.tail->next;
         to_visit.erase(neighbor);
+        ++stats_.tail_extension_successes;
 #ifdef DEBUG
         std::cerr << "\t"
                   << "[SUCCESS]" << std::endl;
 #endif
-        return path;
+        return true;
       }
 #ifdef DEBUG
       std::cerr << "\t"
@@ -286,7 +606,7 @@ std::optional<Path> PathFinder::Extend_(Path path,
 #endif
     }
   }
-  for (const auto& neighbor : adjacency_list_.at(path.head->vertex)) {
+  for (const auto& neighbor : graph.at(path.head->vertex)) {
     if (to_visit.find(neighbor) != to_visit.cend()) {
 #ifdef DEBUG
       std::cerr << "Extend " << path.head->vertex.first->GetName() << " "
@@ -295,33 +615,20 @@ std::optional<Path> PathFinder::Extend_(Path path,
                 << neighbor.second->GetName() << "...";
 #endif
 
-      auto edge = Edge{};
-      auto free_nets = FindFreeNets(*path.head);
-      for (auto free_net : free_nets.p) {
-        if (free_net == neighbor.first->GetSource()
-            || free_net == neighbor.first->GetDrain()) {
-          edge.first = free_net;
-          break;
-        }
-      }
-      for (auto free_net : free_nets.n) {
-        if (free_net == neighbor.second->GetSource()
-            || free_net == neighbor.second->GetDrain()) {
-          edge.second = free_net;
-          break;
-        }
-      }
-      if (edge.first && edge.second) {
+      ++stats_.head_extension_attempts;
+      ++stats_.free_net_computations;
+      if (auto edge = EdgeTo(FindFreeNets(*path.head), neighbor); edge) {
         auto head = std::make_shared<PathFragment>(
-            neighbor, std::weak_ptr<PathFragment>{}, path.head, edge);
+            neighbor, std::weak_ptr<PathFragment>{}, path.head, *edge);
         path.head->prev = head;
         path.head = head;
         to_visit.erase(neighbor);
+        ++stats_.head_extension_successes;
 #ifdef DEBUG
         std::cerr << "\t"
                   << "[SUCCESS]" << std::endl;
 #endif
-        return path;
+        return true;
       }
 #ifdef DEBUG
       std::cerr << "\t"
@@ -329,100 +636,90 @@ std::optional<Path> PathFinder::Extend_(Path path,
 #endif
     }
   }
-  return std::nullopt;
+  return false;
 }
 
-std::vector<Path> PathFinder::Rotate_(const Path& path) const {
+bool PathFinder::RotateAndExtend_(Path& path, std::set<Vertex>& to_visit,
+                                  const Graph& graph, std::size_t depth,
+                                  std::set<Vertex>& endpoints) const {
   // Length smaller than 3 cannot be rotated.
-  if (path.head == path.tail || path.head->next == path.tail) {
-    return {};
-  }
-  auto rotated_paths = std::vector<Path>{};
-  // If the start or end vertex has a short cut to the vertex in the middle of
-  // the path, that vertex becomes the new end or start vertex, respectively.
-  // NOTE: The rotation is actually a reverse.
-  for (auto curr = path.head->next->next /* skip the immediate neighbor */;
-       curr; curr = curr->next) {
-    if (IsNeighbor(path.head->vertex, curr->vertex)) {
-      // Make a copy for rotating.
-      auto rotated_path = path;
-      // Fast forward to the corresponding vertex, as we cannot manipulate the
-      // original path.
-      auto rotated_curr = rotated_path.head;
-      while (rotated_curr->vertex != curr->vertex) {
-        rotated_curr = rotated_curr->next;
+  if (depth == 0 || path.head == path.tail || path.head->next == path.tail) {
+    return false;
+  }
+  // If the start vertex can take over the connection between a vertex in the
+  // middle of the path and its previous, the previous becomes the new start
+  // vertex. The rotations of the end vertex are the same on the reversed
+  // path.
+  for (auto is_reversed : {false, true}) {
+    if (is_reversed) {
+      Reverse(path);
+    }
+    ++stats_.free_net_computations;
+    const auto free_nets = FindFreeNets(*path.head);
+    // Start past the head, as a rotation at the head itself would leave the
+    // path as it is.
+    for (auto pivot = path.head->next; pivot->next && !IsTimeUp_();
+         pivot = pivot->next) {
+      if (!HasNet(free_nets.p, pivot->edge_to_next.first)
+          || !HasNet(free_nets.n, pivot->edge_to_next.second)) {
+        continue;
       }
-      // The head takes a shortcut to the curr. The link between the previous of
-      // curr and the curr is broken. Then we reverse the path from the previous
-      // of curr to the head.
-      auto new_head = rotated_curr->prev.lock();
-      new_head->next = nullptr;
-      auto prev = rotated_curr;
-      rotated_curr = rotated_path.head;
-      while (rotated_curr) {
-        auto next = rotated_curr->next;
-        rotated_curr->next = prev;
-        rotated_curr->next->prev = rotated_curr;
-        prev = rotated_curr;
-        rotated_curr = next;
+      ++stats_.rotations_generated;
+      // An endpoint that is already tried would only repeat the search.
+      if (!endpoints.insert(pivot->vertex).second) {
+        continue;
+      }
+      // After the rotation, the only connection of the pivot is the one with
+      // its current previous, so whether it can extend is known without
+      // rotating.
+      const auto& edge_with_prev = pivot->prev.lock()->edge_to_next;
+      ++stats_.free_net_computations;
+      const auto pivot_free_nets = FindFreeNets(pivot->vertex, edge_with_prev);
+      const auto& neighbors = graph.at(pivot->vertex);
+      const auto can_extend = std::any_of(
+          neighbors.cbegin(), neighbors.cend(),
+          [&to_visit, &pivot_free_nets](const Vertex& neighbor) {
+            return to_visit.find(neighbor) != to_visit.cend()
+                   && EdgeTo(pivot_free_nets, neighbor);
+          });
+      if (!can_extend && depth <= 1) {
+        continue;
       }
+      ++stats_.rotations_tried;
+      const auto head = path.head;
+      RotateHead(path, pivot);
 #ifdef DEBUG
       std::cerr << "=== Rotated path ===" << std::endl;
-      PrintPath(rotated_path);
+      PrintPath(path);
 #endif
-      rotated_paths.push_back(std::move(rotated_path));
+      if ((can_extend && Extend_(path, to_visit, graph))
+          || (depth > 1
+              && RotateAndExtend_(path, to_visit, graph, depth - 1,
+                                  endpoints))) {
+        return true;
+      }
+      // The rotation is its own inverse: the old head is now where the pivot
+      // was, and taking it as the pivot brings the path back.
+      RotateHead(path, head);
     }
   }
+  Reverse(path);
+  return false;
+}
 
-  for (auto curr = path.head;
-       curr->next->next /* skip the immediate neighbor */; curr = curr->next) {
-    if (IsNeighbor(path.tail->vertex, curr->vertex)) {
-      // Make a copy for rotating.
-      auto rotated_path = path;
-      // Fast forward to the corresponding vertex, as we cannot manipulate the
-      // original path.
-      auto rotated_curr = rotated_path.head;
-      while (rotated_curr->vertex != curr->vertex) {
-        rotated_curr = rotated_curr->next;
-      }
-      // The curr takes the shortcut to the tail. The link between
-      // the curr and the next of curr is broken. Then we reverse the path from
-      // the next of curr to the tail.
-      rotated_curr->next->prev.reset();
-      rotated_curr = rotated_curr->next;
-      rotated_curr->prev.lock()->next = rotated_path.tail;
-      rotated_curr->prev.reset();
-      assert(!rotated_curr->prev.lock());
-      rotated_path.tail = rotated_curr;
-      auto prev = std::shared_ptr<PathFragment>{};
-      while (rotated_curr) {
-        auto next = rotated_curr->next;
-        rotated_curr->next = prev;
-        rotated_curr->next->prev = rotated_curr;
-        prev = rotated_curr;
-        rotated_curr = next;
-      }
-#ifdef DEBUG
-      std::cerr << "=== Rotated path ===" << std::endl;
-      PrintPath(rotated_path);
-#endif
-      rotated_paths.push_back(std::move(rotated_path));
-    }
+bool PathFinder::IsTimeUp_() const {
+  if (option_.time_limit.count() == 0
+      || std::chrono::steady_clock::now() < deadline_) {
+    return false;
   }
-  return rotated_paths;
+  stats_.is_time_limit_hit = true;
+  return true;
 }
 
 double PathFinder::CalculateHpwl_(const Path& path) const {
-  // Design rule parameters.
-  constexpr auto kVerticalWidthIncrement = 27.0;
-  constexpr auto kHorizontalExtension = 25.0;
-  constexpr auto kGateSpacing = 34.0;
-  constexpr auto kHorizontalGateWidth = 20.0;
-  constexpr auto kUnitHorizontalWidth = kGateSpacing + kHorizontalGateWidth;
-
   auto net_order = GetEdgesWithGateExcludedOf(path);
   auto nets = std::vector<std::shared_ptr<Net>>{};
-  for (const auto& [_, net] : circuit_->nets) {
+  for (const auto& [_, net] : circuit_.nets) {
     nets.push_back(net);
   }
   auto hpwl = 0.0;
@@ -536,20 +833,24 @@ Path ConnectHamiltonPathOfSubgraphsWithDummy(const std::vector<Path>& paths) {
     // Get the net that is free (not already used as an edge) to be connected
     // with the dummy.
     // The 2 dummies are connected with the dummy net.
-    auto dummy_net = std::make_shared<Net>("Dummy");
+    auto dummy_net = Net::CreateDummy();
     auto ending_vertex = paths.at(i - 1).tail;
     auto ending_free_net = FindFreeNets(*ending_vertex);
     assert(ending_free_net.p.size() >= 1 && ending_free_net.n.size() >= 1);
+    // A path of a single vertex can be placed either way. Follow the hint of
+    // the tail, if any.
+    PreferFront(ending_free_net.p, ending_vertex->edge_to_next.first);
+    PreferFront(ending_free_net.n, ending_vertex->edge_to_next.second);
     // The size of the dummy is the same as the MOS next to it.
     auto ending_dummy
-        = Vertex{Mos::Create("Dummy", Mos::Type::kP, ending_free_net.p.front(),
-                             dummy_net, dummy_net, dummy_net,
-                             ending_vertex->vertex.first->GetWidth(),
-                             ending_vertex->vertex.first->GetLength()),
-                 Mos::Create("Dummy", Mos::Type::kN, ending_free_net.n.front(),
-                             dummy_net, dummy_net, dummy_net,
-                             ending_vertex->vertex.second->GetWidth(),
-                             ending_vertex->vertex.second->GetLength())};
+        = Vertex{Mos::CreateDummy(Mos::Type::kP, ending_free_net.p.front(),
+                                  dummy_net, dummy_net, dummy_net,
+                                  ending_vertex->vertex.first->GetWidth(),
+                                  ending_vertex->vertex.first->GetLength()),
+                 Mos::CreateDummy(Mos::Type::kN, ending_free_net.n.front(),
+                                  dummy_net, dummy_net, dummy_net,
+                                  ending_vertex->vertex.second->GetWidth(),
+                                  ending_vertex->vertex.second->GetLength())};
     auto next_of_ending_vertex
         = std::make_shared<PathFragment>(ending_dummy, ending_vertex);
     ending_vertex->next = next_of_ending_vertex;
@@ -558,15 +859,20 @@ Path ConnectHamiltonPathOfSubgraphsWithDummy(const std::vector<Path>& paths) {
 
     auto starting_vertex = paths.at(i).head;
     auto starting_free_net = FindFreeNets(*starting_vertex);
+    if (!starting_vertex->next) {
+      // The hint is for the right side, so the left side takes the other one.
+      PreferBack(starting_free_net.p, starting_vertex->edge_to_next.first);
+      PreferBack(starting_free_net.n, starting_vertex->edge_to_next.second);
+    }
     auto starting_dummy = Vertex{
-        Mos::Create("Dummy", Mos::Type::kP, starting_free_net.p.front(),
-                    dummy_net, dummy_net, dummy_net,
-                    starting_vertex->vertex.first->GetWidth(),
-                    starting_vertex->vertex.first->GetLength()),
-        Mos::Create("Dummy", Mos::Type::kN, starting_free_net.n.front(),
-                    dummy_net, dummy_net, dummy_net,
-                    starting_vertex->vertex.second->GetWidth(),
-                    starting_vertex->vertex.second->GetLength())};
+        Mos::CreateDummy(Mos::Type::kP, starting_free_net.p.front(),
+                         dummy_net, dummy_net, dummy_net,
+                         starting_vertex->vertex.first->GetWidth(),
+                         starting_vertex->vertex.first->GetLength()),
+        Mos::CreateDummy(Mos::Type::kN, starting_free_net.n.front(),
+                         dummy_net, dummy_net, dummy_net,
+                         starting_vertex->vertex.second->GetWidth(),
+                         starting_vertex->vertex.second->GetLength())};
     auto prev_of_starting_vertex = std::make_shared<PathFragment>(
         starting_dummy, std::weak_ptr<PathFragment>{}, starting_vertex,
         std::make_pair(starting_free_net.p.front(),
@@ -581,6 +887,18 @@ Path ConnectHamiltonPathOfSubgraphsWithDummy(const std::vector<Path>& paths) {
   return path;
 }
 
+void PreferFront(std::vector<std::shared_ptr<Net>>& nets,
+                 const std::shared_ptr<Net>& net) {
+  std::stable_partition(nets.begin(), nets.end(),
+                        [&net](const auto& n) { return n == net; });
+}
+
+void PreferBack(std::vector<std::shared_ptr<Net>>& nets,
+                const std::shared_ptr<Net>& net) {
+  std::stable_partition(nets.begin(), nets.end(),
+                        [&net](const auto& n) { return n != net; });
+}
+
 std::vector<Edge> GetEdgesOf(const Path& path) {
   auto edges = std::vector<Edge>{};
   auto free_nets_of_head = FindFreeNets(*path.head);
@@ -627,33 +945,47 @@ std::vector<std::shared_ptr<Net>> NetsOf(const Mos& mos) {
   return {mos.GetDrain(), mos.GetGate(), mos.GetSource()};
 }
 
-FreeNets FindFreeNets(const PathFragment& fragment) {
+bool HasNet(const std::vector<std::shared_ptr<Net>>& nets,
+            const std::shared_ptr<Net>& net) {
+  return std::find(nets.cbegin(), nets.cend(), net) != nets.cend();
+}
+
+/// @param edges The connections of the vertex, which are not free.
+FreeNets FindFreeNets(const Vertex& vertex,
+                      std::initializer_list<const Edge*> edges) {
 #ifdef DEBUG
-  std::cerr << "=== Find free nets of " << fragment.vertex.first->GetName()
-            << "\t" << fragment.vertex.second->GetName() << " ===" << std::endl;
+  std::cerr << "=== Find free nets of " << vertex.first->GetName() << "\t"
+            << vertex.second->GetName() << " ===" << std::endl;
 #endif
 
-  auto net_count_of_p_most = std::map<std::shared_ptr<Net>, std::size_t>{};
-  for (auto net : NetsOf(*fragment.vertex.first)) {
-    ++net_count_of_p_most[net];
+  // The nets are counted in the order of the pins, not of their addresses,
+  // as the first free net is the one taken.
+  using NetCounts = std::vector<std::pair<std::shared_ptr<Net>, std::size_t>>;
+  const auto CountOf = [](NetCounts& net_counts,
+                          const std::shared_ptr<Net>& net) -> std::size_t& {
+    auto it = std::find_if(
+        net_counts.begin(), net_counts.end(),
+        [&net](const auto& net_count) { return net_count.first == net; });
+    if (it == net_counts.end()) {
+      return net_counts.emplace_back(net, 0).second;
+    }
+    return it->second;
+  };
+  auto net_count_of_p_most = NetCounts{};
+  for (auto net : NetsOf(*vertex.first)) {
+    ++CountOf(net_count_of_p_most, net);
   }
-  auto net_count_of_n_most = std::map<std::shared_ptr<Net>, std::size_t>{};
-  for (auto net : NetsOf(*fragment.vertex.second)) {
-    ++net_count_of_n_most[net];
+  auto net_count_of_n_most = NetCounts{};
+  for (auto net : NetsOf(*vertex.second)) {
+    ++CountOf(net_count_of_n_most, net);
   }
   // Remove gate from the count.
-  --net_count_of_p_most[fragment.vertex.first->GetGate()];
-  --net_count_of_n_most[fragment.vertex.second->GetGate()];
-  // Remove the connection between the fragment and the next fragment, if any.
-  if (fragment.next) {
-    --net_count_of_p_most[fragment.edge_to_next.first];
-    --net_count_of_n_most[fragment.edge_to_next.second];
-  }
-  // Remove the connection between the fragment and the previous fragment, if
-  // any.
-  if (auto prev = fragment.prev.lock()) {
-    --net_count_of_p_most[prev->edge_to_next.first];
-    --net_count_of_n_most[prev->edge_to_next.second];
+  --CountOf(net_count_of_p_most, vertex.first->GetGate());
+  --CountOf(net_count_of_n_most, vertex.second->GetGate());
+  // Remove the connections.
+  for (const auto* edge : edges) {
+    --CountOf(net_count_of_p_most, edge->first);
+    --CountOf(net_count_of_n_most, edge->second);
   }
   auto free_nets = FreeNets{};
   for (const auto& [net, count] : net_count_of_p_most) {
@@ -680,4 +1012,68 @@ FreeNets FindFreeNets(const PathFragment& fragment) {
 #endif
   return free_nets;
 }
+
+FreeNets FindFreeNets(const PathFragment& fragment) {
+  // The connection between the fragment and the next fragment, if any, and
+  // the one between the fragment and the previous fragment, if any.
+  auto prev = fragment.prev.lock();
+  if (fragment.next && prev) {
+    return FindFreeNets(fragment.vertex,
+                        {&fragment.edge_to_next, &prev->edge_to_next});
+  }
+  if (fragment.next) {
+    return FindFreeNets(fragment.vertex, {&fragment.edge_to_next});
+  }
+  if (prev) {
+    return FindFreeNets(fragment.vertex, {&prev->edge_to_next});
+  }
+  return FindFreeNets(fragment.vertex, {});
+}
+
+FreeNets FindFreeNets(const Vertex& vertex, const Edge& edge) {
+  return FindFreeNets(vertex, {&edge});
+}
+
+std::optional<Edge> EdgeTo(const FreeNets& free_nets, const Vertex& neighbor) {
+  auto edge = Edge{};
+  for (auto free_net : free_nets.p) {
+    if (free_net == neighbor.first->GetSource()
+        || free_net == neighbor.first->GetDrain()) {
+      edge.first = free_net;
+      break;
+    }
+  }
+  for (auto free_net : free_nets.n) {
+    if (free_net == neighbor.second->GetSource()
+        || free_net == neighbor.second->GetDrain()) {
+      edge.second = free_net;
+      break;
+    }
+  }
+  if (edge.first && edge.second) {
+    return edge;
+  }
+  return std::nullopt;
+}
+
+void RotateHead(Path& path, const std::shared_ptr<PathFragment>& new_head) {
+  auto next = new_head->next;
+  auto edge = new_head->edge_to_next;
+  auto curr = path.head;
+  while (true) {
+    auto prev_next = curr->next;
+    auto prev_edge = curr->edge_to_next;
+    curr->next = next;
+    curr->edge_to_next = edge;
+    next->prev = curr;
+    if (curr == new_head) {
+      break;
+    }
+    next = curr;
+    edge = prev_edge;
+    curr = prev_next;
+  }
+  new_head->prev.reset();
+  path.head = new_head;
+}
 }  // namespace
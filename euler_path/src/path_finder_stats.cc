@@ -0,0 +1,32 @@
+#include "path_finder_stats.h"
+
+#include <ostream>
+
+using namespace euler;
+
+void PathFinderStats::Out(std::ostream& out, const char* indent) const {
+  const auto Key = [&out, indent](const char* key) -> std::ostream& {
+    return out << indent << "  \"" << key << "\": ";
+  };
+  out << "{\n";
+  Key("head_extension_attempts") << head_extension_attempts.load() << ",\n";
+  Key("head_extension_successes") << head_extension_successes.load() << ",\n";
+  Key("tail_extension_attempts") << tail_extension_attempts.load() << ",\n";
+  Key("tail_extension_successes") << tail_extension_successes.load() << ",\n";
+  Key("rotations_generated") << rotations_generated.load() << ",\n";
+  Key("rotations_tried") << rotations_tried.load() << ",\n";
+  Key("free_net_computations") << free_net_computations.load() << ",\n";
+  Key("sub_paths") << sub_paths.load() << ",\n";
+  Key("starts") << starts.load() << ",\n";
+  Key("dummies") << dummies << ",\n";
+  Key("cache_hit") << (is_cache_hit ? "true" : "false") << ",\n";
+  Key("time_limit_hit") << (is_time_limit_hit ? "true" : "false") << ",\n";
+  Key("canonical_form_ms") << canonical_form.count() << ",\n";
+  Key("group_vertices_ms") << group_vertices.count() << ",\n";
+  Key("build_graph_ms") << build_graph.count() << ",\n";
+  Key("exact_solver_ms") << exact_solver.count() << ",\n";
+  Key("heuristic_ms") << heuristic.count() << ",\n";
+  Key("local_search_ms") << local_search.count() << ",\n";
+  Key("total_ms") << total.count() << '\n';
+  out << indent << '}';
+}
@@ -0,0 +1,139 @@
+#include "scanner.h"
+
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include "mos.h"
+#include "symbol.h"
+#include "y.tab.hh"
+
+using namespace euler;
+
+namespace {
+
+bool IsNameStart(int c) {
+  return std::isalpha(c) || c == '_';
+}
+
+bool IsNamePart(int c) {
+  return std::isalnum(c) || c == '_';
+}
+
+bool IsDigit(int c) {
+  return std::isdigit(c);
+}
+
+/// @return Whether `word` is `keyword` ignoring the case. `keyword` is in
+/// lower case.
+bool IsKeyword(std::string_view word, std::string_view keyword) {
+  if (word.size() != keyword.size()) {
+    return false;
+  }
+  for (auto i = std::size_t{0}; i < word.size(); i++) {
+    if (std::tolower(static_cast<unsigned char>(word[i])) != keyword[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+yy::parser::symbol_type Scanner::Lex() {
+  if (is_after_newline_) {
+    ++line_no_;
+    is_after_newline_ = false;
+  }
+  while (true) {
+    const auto c = in_.get();
+    if (c == std::istream::traits_type::eof()) {
+      return yy::parser::make_EOF();
+    }
+    if (c == ' ' || c == '\t' || c == '\r') {
+      continue;
+    }
+    if (c == '\n') {
+      is_after_newline_ = true;
+      return yy::parser::make_EOL();
+    }
+    if (c == '=') {
+      return yy::parser::symbol_type{c};
+    }
+    /* keywords */
+    if (c == '.') {
+      if (IsNameStart(in_.peek())) {
+        const auto word = ScanName_(static_cast<char>(in_.get()));
+        if (IsKeyword(word, "subckt")) {
+          return yy::parser::make_SUBCKT();
+        }
+        if (IsKeyword(word, "ends")) {
+          return yy::parser::make_ENDS();
+        }
+      }
+      throw yy::parser::syntax_error{"Invalid input: ."};
+    }
+    if (IsNameStart(c)) {
+      const auto word = ScanName_(static_cast<char>(c));
+      // Note: several keywords can also be matched as a name.
+      // We have them take the priority.
+      if (IsKeyword(word, "pmos_rvt")) {
+        return yy::parser::make_MOS_TYPE(Mos::Type::kP);
+      }
+      if (IsKeyword(word, "nmos_rvt")) {
+        return yy::parser::make_MOS_TYPE(Mos::Type::kN);
+      }
+      // support only nano meter
+      if (IsKeyword(word, "n")) {
+        return yy::parser::make_UNIT();
+      }
+      if (IsKeyword(word, "l")) {
+        return yy::parser::make_LENGTH();
+      }
+      if (IsKeyword(word, "w")) {
+        return yy::parser::make_WIDTH();
+      }
+      if (IsKeyword(word, "nfin")) {
+        return yy::parser::make_NFIN();
+      }
+      return yy::parser::make_NAME(SymbolTable::Instance().Intern(word));
+    }
+    if (IsDigit(c)) {
+      return yy::parser::make_NUMBER(ScanNumber_(static_cast<char>(c)));
+    }
+    throw yy::parser::syntax_error{"Invalid input: "
+                                   + std::string(1, static_cast<char>(c))};
+  }
+}
+
+std::string_view Scanner::ScanName_(char first) {
+  name_.assign(1, first);
+  while (IsNamePart(in_.peek())) {
+    name_.push_back(static_cast<char>(in_.get()));
+  }
+  return name_;
+}
+
+double Scanner::ScanNumber_(char first) {
+  // positive integer or floating point number
+  auto number = std::string(1, first);
+  while (IsDigit(in_.peek())) {
+    number.push_back(static_cast<char>(in_.get()));
+  }
+  if (in_.peek() == '.') {
+    in_.get();
+    if (IsDigit(in_.peek())) {
+      number.push_back('.');
+      while (IsDigit(in_.peek())) {
+        number.push_back(static_cast<char>(in_.get()));
+      }
+    } else {
+      // The dot is not part of the number.
+      in_.unget();
+    }
+  }
+  return std::strtod(number.c_str(), nullptr);
+}
@@ -0,0 +1,68 @@
+#include "symbol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+
+using namespace euler;
+
+SymbolTable& SymbolTable::Instance() {
+  static auto symbol_table = SymbolTable{};
+  return symbol_table;
+}
+
+Symbol SymbolTable::Intern(std::string_view name) {
+  {
+    auto lock = std::shared_lock{mutex_};
+    if (auto it = symbols_.find(name); it != symbols_.end()) {
+      return it->second;
+    }
+  }
+  auto lock = std::unique_lock{mutex_};
+  // Another thread may have interned it between the locks.
+  if (auto it = symbols_.find(name); it != symbols_.end()) {
+    return it->second;
+  }
+  if (number_of_names_ % kChunkSize == 0) {
+    AddChunk_();
+  }
+  const auto symbol = static_cast<Symbol>(number_of_names_++);
+  const auto stored = Store_(name);
+  chunks_.back()->at(symbol % kChunkSize) = stored;
+  symbols_.emplace(stored, symbol);
+  return symbol;
+}
+
+std::string_view SymbolTable::NameOf(Symbol symbol) const {
+  // The symbol is handed over from the thread that interned it, so its name
+  // is already written.
+  const auto* directory = directory_.load(std::memory_order_acquire);
+  return directory->at(symbol / kChunkSize)->at(symbol % kChunkSize);
+}
+
+void SymbolTable::AddChunk_() {
+  chunks_.push_back(std::make_unique<Chunk>());
+  auto directory = std::make_unique<Directory>();
+  directory->reserve(chunks_.size());
+  for (const auto& chunk : chunks_) {
+    directory->push_back(chunk.get());
+  }
+  directory_.store(directory.get(), std::memory_order_release);
+  directories_.push_back(std::move(directory));
+}
+
+std::string_view SymbolTable::Store_(std::string_view name) {
+  if (static_cast<std::size_t>(end_ - next_) < name.size()) {
+    const auto size = std::max(kBlockSize, name.size());
+    blocks_.push_back(std::make_unique<char[]>(size));
+    next_ = blocks_.back().get();
+    end_ = next_ + size;
+  }
+  auto* begin = next_;
+  next_ = std::copy(name.begin(), name.end(), next_);
+  return {begin, name.size()};
+}
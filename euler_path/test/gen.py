@@ -0,0 +1,169 @@
+import argparse
+import random
+from dataclasses import dataclass, field
+from typing import Final, List, Union
+
+
+@dataclass
+class Transistor:
+    gate: str
+
+
+@dataclass
+class Network:
+    """A series or parallel composition of transistors and sub-networks."""
+
+    is_series: bool
+    children: List[Union["Network", Transistor]] = field(default_factory=list)
+
+
+@dataclass
+class Mos:
+    drain: str
+    gate: str
+    source: str
+    is_p: bool
+
+
+class Netlist:
+    def __init__(self) -> None:
+        self.mos: List[Mos] = []
+        self.num_of_internal_nets: int = 0
+
+    def new_net(self) -> str:
+        self.num_of_internal_nets += 1
+        return f"net{self.num_of_internal_nets}"
+
+    def add(
+        self,
+        network: Union[Network, Transistor],
+        top: str,
+        bottom: str,
+        is_p: bool,
+        is_dual: bool,
+    ) -> None:
+        """
+        Places the network between the nets `top` and `bottom`. The dual
+        network swaps series with parallel, which is how the pull-up network
+        complements the pull-down one.
+        """
+        if isinstance(network, Transistor):
+            # The drain and the source are swapped at random, as they are in
+            # the real netlists.
+            drain, source = (top, bottom) if random.random() < 0.5 else (bottom, top)
+            self.mos.append(Mos(drain, network.gate, source, is_p))
+            return
+        if network.is_series != is_dual:
+            nets = [top]
+            for _ in range(len(network.children) - 1):
+                nets.append(self.new_net())
+            nets.append(bottom)
+            for i, child in enumerate(network.children):
+                self.add(child, nets[i], nets[i + 1], is_p, is_dual)
+        else:
+            for child in network.children:
+                self.add(child, top, bottom, is_p, is_dual)
+
+
+def gen_network(inputs: List[str]) -> Union[Network, Transistor]:
+    """Generates a random series-parallel network with each input used once."""
+    if len(inputs) == 1:
+        return Transistor(inputs[0])
+    num_of_children: int = random.randint(2, len(inputs))
+    # Split the inputs into non-empty groups.
+    cuts: List[int] = sorted(random.sample(range(1, len(inputs)), num_of_children - 1))
+    groups: List[List[str]] = [
+        inputs[begin:end] for begin, end in zip([0] + cuts, cuts + [len(inputs)])
+    ]
+    network = Network(random.random() < 0.5)
+    for group in groups:
+        child = gen_network(group)
+        # Nested compositions of the same kind are flattened.
+        if isinstance(child, Network) and child.is_series == network.is_series:
+            network.children.extend(child.children)
+        else:
+            network.children.append(child)
+    return network
+
+
+def gen(num_of_stages: int, max_num_of_inputs: int, num_of_primary_inputs: int) -> str:
+    """
+    Each stage is a complementary CMOS gate of a random series-parallel
+    pull-down network and its dual pull-up network. The inputs of a stage are
+    taken from the primary inputs and the outputs of the previous stages.
+    """
+    VDD: Final[str] = "VDD"
+    VSS: Final[str] = "VSS"
+    netlist = Netlist()
+    primary_inputs: List[str] = [f"I{i}" for i in range(num_of_primary_inputs)]
+    signals: List[str] = list(primary_inputs)
+    for stage in range(num_of_stages):
+        # The later stages prefer the recent outputs, as a flattened block has
+        # mostly local connections.
+        candidates: List[str] = signals[-(2 * max_num_of_inputs + num_of_primary_inputs) :]
+        k: int = random.randint(1, min(max_num_of_inputs, len(candidates)))
+        inputs: List[str] = random.sample(candidates, k=k)
+        output: str = f"O{stage}"
+        network = gen_network(inputs)
+        netlist.add(network, output, VSS, is_p=False, is_dual=False)
+        netlist.add(network, VDD, output, is_p=True, is_dual=True)
+        signals.append(output)
+
+    lines: List[str] = []
+    ports: List[str] = primary_inputs + [signals[-1], VDD, VSS]
+    lines.append(f".SUBCKT CMOS{num_of_stages} {' '.join(ports)}\n")
+    for i, mos in enumerate(netlist.mos):
+        if mos.is_p:
+            lines.append(
+                f"MM{i} {mos.drain} {mos.gate} {mos.source} {VDD} pmos_rvt w=162.0n l=20n nfin=6\n"
+            )
+        else:
+            lines.append(
+                f"MM{i} {mos.drain} {mos.gate} {mos.source} {VSS} nmos_rvt w=81.0n l=20n nfin=3\n"
+            )
+    # The same as the sample netlists, there's no end of file newline.
+    lines.append(".ENDS")
+    return "".join(lines)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter,
+        description="""
+Generates a complementary CMOS netlist to the file cmos{num_of_stages}.sp.
+A single stage gives a random complex gate, a few give a multi-stage cell, and
+hundreds give a flattened macro with thousands of transistors.
+The format is as the following:
+
+    ```
+    .SUBCKT <circuit name> [<net name>]+
+    [M<name> <drain> <gate> <source> <substrate> <pmos_rvt|nmos_rvt> w=<width>n l=<length>n nfin=<fin number>]+
+    .ENDS
+    ```
+""",
+    )
+
+    def positive_int(value: str) -> int:
+        int_value = int(value)
+        if int_value <= 0:
+            raise argparse.ArgumentTypeError(f"{int_value} is not a positive int")
+        return int_value
+
+    parser.add_argument("num_of_stages", type=positive_int)
+    parser.add_argument(
+        "--max-inputs",
+        type=positive_int,
+        default=4,
+        help="the maximum number of inputs of a stage (default: 4)",
+    )
+    parser.add_argument(
+        "--primary-inputs",
+        type=positive_int,
+        default=4,
+        help="the number of inputs of the netlist (default: 4)",
+    )
+    parser.add_argument("--seed", type=int, help="the random seed")
+    args: argparse.Namespace = parser.parse_args()
+    random.seed(args.seed)
+    with open(f"cmos{args.num_of_stages}.sp", mode="w+") as f:
+        f.write(gen(args.num_of_stages, args.max_inputs, args.primary_inputs))
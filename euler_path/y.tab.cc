@@ -1,8 +1,8 @@
-// A Bison parser, made by GNU Bison 3.5.1.
+// A Bison parser, made by GNU Bison 3.8.2.
 
 // Skeleton implementation for Bison LALR(1) parsers in C++
 
-// Copyright (C) 2002-2015, 2018-2020 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -15,7 +15,7 @@
 // GNU General Public License for more details.
 
 // You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // As a special exception, you may create a larger work that contains
 // part or all of the Bison parser skeleton and distribute that work
@@ -30,37 +30,41 @@
 // This special exception was added by the Free Software Foundation in
 // version 2.2 of Bison.
 
-// Undocumented macros, especially those whose name start with YY_,
-// are private implementation details.  Do not rely on them.
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
 
 
-// First part of user prologue.
-#line 5 "parser.y"
 
 
+#include "y.tab.hh"
+
+
+// Unqualified %code blocks.
+#line 32 "parser.y"
+
 #include <iostream>
+#include <istream>
 #include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
-#include "lex.yy.cc"
-#include "circuit.h"
+#include "parse.h"
+#include "scanner.h"
 
-extern std::shared_ptr<euler::Circuit> circuit;
-
-static std::map<std::string, std::shared_ptr<euler::Net>> nets;
-
-static std::shared_ptr<euler::Net> GetOrCreateNet(const std::string& name);
-static std::shared_ptr<euler::Net> GetNetOrNull(const std::string& name);
-static void RegisterNet(std::shared_ptr<euler::Net> net);
-
-#line 59 "y.tab.cc"
-
-
-#include "y.tab.hh"
+static yy::parser::symbol_type yylex(euler::Scanner& scanner);
 
+static std::shared_ptr<euler::Net> GetOrCreateNet(
+    euler::ParseContext& context, euler::Symbol name);
+static std::shared_ptr<euler::Net> GetNetOrNull(
+    const euler::ParseContext& context, euler::Symbol name);
+static void RegisterNet(euler::ParseContext& context,
+                        std::shared_ptr<euler::Net> net);
 
+#line 68 "y.tab.cc"
 
 
 #ifndef YY_
@@ -75,6 +79,7 @@ static void RegisterNet(std::shared_ptr<euler::Net> net);
 # endif
 #endif
 
+
 // Whether we are compiled with exception support.
 #ifndef YY_EXCEPTIONS
 # if defined __GNUC__ && !defined __EXCEPTIONS
@@ -111,13 +116,13 @@ static void RegisterNet(std::shared_ptr<euler::Net> net);
 # define YY_STACK_PRINT()               \
   do {                                  \
     if (yydebug_)                       \
-      yystack_print_ ();                \
+      yy_stack_print_ ();                \
   } while (false)
 
 #else // !YYDEBUG
 
 # define YYCDEBUG if (false) std::cerr
-# define YY_SYMBOL_PRINT(Title, Symbol)  YYUSE (Symbol)
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
 # define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
 # define YY_STACK_PRINT()                static_cast<void> (0)
 
@@ -132,59 +137,19 @@ static void RegisterNet(std::shared_ptr<euler::Net> net);
 #define YYRECOVERING()  (!!yyerrstatus_)
 
 namespace yy {
-#line 136 "y.tab.cc"
-
-
-  /* Return YYSTR after stripping away unnecessary quotes and
-     backslashes, so that it's suitable for yyerror.  The heuristic is
-     that double-quoting is unnecessary unless the string contains an
-     apostrophe, a comma, or backslash (other than backslash-backslash).
-     YYSTR is taken from yytname.  */
-  std::string
-  parser::yytnamerr_ (const char *yystr)
-  {
-    if (*yystr == '"')
-      {
-        std::string yyr;
-        char const *yyp = yystr;
-
-        for (;;)
-          switch (*++yyp)
-            {
-            case '\'':
-            case ',':
-              goto do_not_strip_quotes;
-
-            case '\\':
-              if (*++yyp != '\\')
-                goto do_not_strip_quotes;
-              else
-                goto append;
-
-            append:
-            default:
-              yyr += *yyp;
-              break;
-
-            case '"':
-              return yyr;
-            }
-      do_not_strip_quotes: ;
-      }
-
-    return yystr;
-  }
-
+#line 141 "y.tab.cc"
 
   /// Build a parser object.
-  parser::parser ()
+  parser::parser (euler::Scanner& scanner_yyarg, euler::ParseContext& parse_context_yyarg)
 #if YYDEBUG
     : yydebug_ (false),
       yycdebug_ (&std::cerr),
 #else
     :
 #endif
-      yy_lac_established_ (false)
+      yy_lac_established_ (false),
+      scanner (scanner_yyarg),
+      parse_context (parse_context_yyarg)
   {}
 
   parser::~parser ()
@@ -193,9 +158,9 @@ namespace yy {
   parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
   {}
 
-  /*---------------.
-  | Symbol types.  |
-  `---------------*/
+  /*---------.
+  | symbol.  |
+  `---------*/
 
 
 
@@ -225,13 +190,13 @@ namespace yy {
     : state (s)
   {}
 
-  parser::symbol_number_type
-  parser::by_state::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
   {
     if (state == empty_state)
-      return empty_symbol;
+      return symbol_kind::S_YYEMPTY;
     else
-      return yystos_[+state];
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
   }
 
   parser::stack_symbol_type::stack_symbol_type ()
@@ -240,25 +205,25 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
     : super_type (YY_MOVE (that.state))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.YY_MOVE_OR_COPY< double > (YY_MOVE (that.value));
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.YY_MOVE_OR_COPY< euler::Mos::Type > (YY_MOVE (that.value));
         break;
 
-      case 16: // mos
-        value.YY_MOVE_OR_COPY< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
+      case symbol_kind::S_NAME: // NAME
+        value.YY_MOVE_OR_COPY< euler::Symbol > (YY_MOVE (that.value));
         break;
 
-      case 10: // NAME
-        value.YY_MOVE_OR_COPY< std::string > (YY_MOVE (that.value));
+      case symbol_kind::S_mos: // mos
+        value.YY_MOVE_OR_COPY< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.YY_MOVE_OR_COPY< std::vector<std::shared_ptr<euler::Mos>> > (YY_MOVE (that.value));
         break;
 
@@ -275,25 +240,25 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
     : super_type (s)
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.move< double > (YY_MOVE (that.value));
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.move< euler::Mos::Type > (YY_MOVE (that.value));
         break;
 
-      case 16: // mos
-        value.move< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
+      case symbol_kind::S_NAME: // NAME
+        value.move< euler::Symbol > (YY_MOVE (that.value));
         break;
 
-      case 10: // NAME
-        value.move< std::string > (YY_MOVE (that.value));
+      case symbol_kind::S_mos: // mos
+        value.move< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.move< std::vector<std::shared_ptr<euler::Mos>> > (YY_MOVE (that.value));
         break;
 
@@ -302,7 +267,7 @@ namespace yy {
     }
 
     // that is emptied.
-    that.type = empty_symbol;
+    that.kind_ = symbol_kind::S_YYEMPTY;
   }
 
 #if YY_CPLUSPLUS < 201103L
@@ -310,25 +275,25 @@ namespace yy {
   parser::stack_symbol_type::operator= (const stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.copy< double > (that.value);
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.copy< euler::Mos::Type > (that.value);
         break;
 
-      case 16: // mos
-        value.copy< std::shared_ptr<euler::Mos> > (that.value);
+      case symbol_kind::S_NAME: // NAME
+        value.copy< euler::Symbol > (that.value);
         break;
 
-      case 10: // NAME
-        value.copy< std::string > (that.value);
+      case symbol_kind::S_mos: // mos
+        value.copy< std::shared_ptr<euler::Mos> > (that.value);
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.copy< std::vector<std::shared_ptr<euler::Mos>> > (that.value);
         break;
 
@@ -343,25 +308,25 @@ namespace yy {
   parser::stack_symbol_type::operator= (stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.move< double > (that.value);
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.move< euler::Mos::Type > (that.value);
         break;
 
-      case 16: // mos
-        value.move< std::shared_ptr<euler::Mos> > (that.value);
+      case symbol_kind::S_NAME: // NAME
+        value.move< euler::Symbol > (that.value);
         break;
 
-      case 10: // NAME
-        value.move< std::string > (that.value);
+      case symbol_kind::S_mos: // mos
+        value.move< std::shared_ptr<euler::Mos> > (that.value);
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.move< std::vector<std::shared_ptr<euler::Mos>> > (that.value);
         break;
 
@@ -386,22 +351,20 @@ namespace yy {
 #if YYDEBUG
   template <typename Base>
   void
-  parser::yy_print_ (std::ostream& yyo,
-                                     const basic_symbol<Base>& yysym) const
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
   {
     std::ostream& yyoutput = yyo;
-    YYUSE (yyoutput);
-    symbol_number_type yytype = yysym.type_get ();
-#if defined __GNUC__ && ! defined __clang__ && ! defined __ICC && __GNUC__ * 100 + __GNUC_MINOR__ <= 408
-    // Avoid a (spurious) G++ 4.8 warning about "array subscript is
-    // below array bounds".
+    YY_USE (yyoutput);
     if (yysym.empty ())
-      std::abort ();
-#endif
-    yyo << (yytype < yyntokens_ ? "token" : "nterm")
-        << ' ' << yytname_[yytype] << " (";
-    YYUSE (yytype);
-    yyo << ')';
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " (";
+        YY_USE (yykind);
+        yyo << ')';
+      }
   }
 #endif
 
@@ -425,7 +388,7 @@ namespace yy {
   }
 
   void
-  parser::yypop_ (int n)
+  parser::yypop_ (int n) YY_NOEXCEPT
   {
     yystack_.pop (n);
   }
@@ -460,21 +423,21 @@ namespace yy {
   parser::state_type
   parser::yy_lr_goto_state_ (state_type yystate, int yysym)
   {
-    int yyr = yypgoto_[yysym - yyntokens_] + yystate;
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
     if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
       return yytable_[yyr];
     else
-      return yydefgoto_[yysym - yyntokens_];
+      return yydefgoto_[yysym - YYNTOKENS];
   }
 
   bool
-  parser::yy_pact_value_is_default_ (int yyvalue)
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yypact_ninf_;
   }
 
   bool
-  parser::yy_table_value_is_error_ (int yyvalue)
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yytable_ninf_;
   }
@@ -502,8 +465,8 @@ namespace yy {
     /// The return value of parse ().
     int yyresult;
 
-    /// Discard the LAC context in case there still is one left from a
-    /// previous invocation.
+    // Discard the LAC context in case there still is one left from a
+    // previous invocation.
     yy_lac_discard_ ("init");
 
 #if YY_EXCEPTIONS
@@ -525,6 +488,7 @@ namespace yy {
   `-----------------------------------------------*/
   yynewstate:
     YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
 
     // Accept?
     if (yystack_[0].state == yyfinal_)
@@ -545,12 +509,12 @@ namespace yy {
     // Read a lookahead token.
     if (yyla.empty ())
       {
-        YYCDEBUG << "Reading a token: ";
+        YYCDEBUG << "Reading a token\n";
 #if YY_EXCEPTIONS
         try
 #endif // YY_EXCEPTIONS
           {
-            symbol_type yylookahead (yylex ());
+            symbol_type yylookahead (yylex (scanner));
             yyla.move (yylookahead);
           }
 #if YY_EXCEPTIONS
@@ -564,13 +528,23 @@ namespace yy {
       }
     YY_SYMBOL_PRINT ("Next token is", yyla);
 
+    if (yyla.kind () == symbol_kind::S_YYerror)
+    {
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
+    }
+
     /* If the proper action on seeing token YYLA.TYPE is to reduce or
        to detect an error, take that action.  */
-    yyn += yyla.type_get ();
-    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.type_get ())
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
       {
-        if (!yy_lac_establish_ (yyla.type_get ()))
-           goto yyerrlab;
+        if (!yy_lac_establish_ (yyla.kind ()))
+          goto yyerrlab;
         goto yydefault;
       }
 
@@ -580,8 +554,8 @@ namespace yy {
       {
         if (yy_table_value_is_error_ (yyn))
           goto yyerrlab;
-        if (!yy_lac_establish_ (yyla.type_get ()))
-           goto yyerrlab;
+        if (!yy_lac_establish_ (yyla.kind ()))
+          goto yyerrlab;
 
         yyn = -yyn;
         goto yyreduce;
@@ -620,23 +594,23 @@ namespace yy {
          when using variants.  */
       switch (yyr1_[yyn])
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         yylhs.value.emplace< double > ();
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         yylhs.value.emplace< euler::Mos::Type > ();
         break;
 
-      case 16: // mos
-        yylhs.value.emplace< std::shared_ptr<euler::Mos> > ();
+      case symbol_kind::S_NAME: // NAME
+        yylhs.value.emplace< euler::Symbol > ();
         break;
 
-      case 10: // NAME
-        yylhs.value.emplace< std::string > ();
+      case symbol_kind::S_mos: // mos
+        yylhs.value.emplace< std::shared_ptr<euler::Mos> > ();
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         yylhs.value.emplace< std::vector<std::shared_ptr<euler::Mos>> > ();
         break;
 
@@ -654,63 +628,77 @@ namespace yy {
         {
           switch (yyn)
             {
-  case 2:
-#line 76 "parser.y"
+  case 9: // circuit: SUBCKT NAME net_list EOL mos_list ENDS
+#line 122 "parser.y"
        {
-    circuit = std::make_shared<euler::Circuit>(yystack_[1].value.as < std::vector<std::shared_ptr<euler::Mos>> > (), std::move(nets));
+    // The nets of the circuit are kept in the order of their names.
+    auto nets = std::map<std::string_view, std::shared_ptr<euler::Net>>{};
+    for (auto& [name, net] : parse_context.nets) {
+      nets.emplace(net->GetName(), std::move(net));
+    }
+    parse_context.circuits.emplace_back(
+        std::string{euler::SymbolTable::Instance().NameOf(yystack_[4].value.as < euler::Symbol > ())},
+        std::move(yystack_[1].value.as < std::vector<std::shared_ptr<euler::Mos>> > ()), std::move(nets));
+    // Nets are not shared across circuits.
+    parse_context.nets.clear();
   }
-#line 663 "y.tab.cc"
+#line 646 "y.tab.cc"
     break;
 
-  case 3:
-#line 82 "parser.y"
+  case 10: // net_list: net_list NAME
+#line 137 "parser.y"
                 {
-    auto net = std::make_shared<euler::Net>(std::move(yystack_[0].value.as < std::string > ()));
-    RegisterNet(net);
+    auto net = std::make_shared<euler::Net>(yystack_[0].value.as < euler::Symbol > ());
+    RegisterNet(parse_context, net);
   }
-#line 672 "y.tab.cc"
+#line 655 "y.tab.cc"
     break;
 
-  case 4:
-#line 86 "parser.y"
+  case 11: // net_list: NAME
+#line 141 "parser.y"
          {
-    auto net = std::make_shared<euler::Net>(std::move(yystack_[0].value.as < std::string > ()));
-    RegisterNet(net);
+    auto net = std::make_shared<euler::Net>(yystack_[0].value.as < euler::Symbol > ());
+    RegisterNet(parse_context, net);
   }
-#line 681 "y.tab.cc"
+#line 664 "y.tab.cc"
     break;
 
-  case 5:
-#line 93 "parser.y"
+  case 12: // mos_list: mos_list mos EOL
+#line 148 "parser.y"
                    {
     yylhs.value.as < std::vector<std::shared_ptr<euler::Mos>> > () = std::move(yystack_[2].value.as < std::vector<std::shared_ptr<euler::Mos>> > ());
     yylhs.value.as < std::vector<std::shared_ptr<euler::Mos>> > ().push_back(yystack_[1].value.as < std::shared_ptr<euler::Mos> > ());
   }
-#line 690 "y.tab.cc"
+#line 673 "y.tab.cc"
     break;
 
-  case 6:
-#line 97 "parser.y"
+  case 13: // mos_list: mos EOL
+#line 152 "parser.y"
             {
     yylhs.value.as < std::vector<std::shared_ptr<euler::Mos>> > () = std::vector<std::shared_ptr<euler::Mos>>{yystack_[1].value.as < std::shared_ptr<euler::Mos> > ()};
   }
-#line 698 "y.tab.cc"
+#line 681 "y.tab.cc"
     break;
 
-  case 7:
-#line 103 "parser.y"
+  case 14: // mos: NAME NAME NAME NAME NAME MOS_TYPE WIDTH '=' NUMBER UNIT LENGTH '=' NUMBER UNIT NFIN '=' NUMBER
+#line 158 "parser.y"
                                                                                                  {
-    auto instance_name = (yystack_[16].value.as < std::string > ()).substr(1);  // Remove the leading 'M'.
-    yylhs.value.as < std::shared_ptr<euler::Mos> > () = euler::Mos::Create(instance_name, /* type */ yystack_[11].value.as < euler::Mos::Type > (), GetOrCreateNet(yystack_[15].value.as < std::string > ()),
-                            GetOrCreateNet(yystack_[14].value.as < std::string > ()), GetOrCreateNet(yystack_[13].value.as < std::string > ()),
-                            GetOrCreateNet(yystack_[12].value.as < std::string > ()), yystack_[8].value.as < double > (), yystack_[4].value.as < double > ());
+    auto& symbol_table = euler::SymbolTable::Instance();
+    // Remove the leading 'M'.
+    auto instance_name
+        = symbol_table.Intern(symbol_table.NameOf(yystack_[16].value.as < euler::Symbol > ()).substr(1));
+    yylhs.value.as < std::shared_ptr<euler::Mos> > () = euler::Mos::Create(instance_name, /* type */ yystack_[11].value.as < euler::Mos::Type > (),
+                            GetOrCreateNet(parse_context, yystack_[15].value.as < euler::Symbol > ()),
+                            GetOrCreateNet(parse_context, yystack_[14].value.as < euler::Symbol > ()),
+                            GetOrCreateNet(parse_context, yystack_[13].value.as < euler::Symbol > ()),
+                            GetOrCreateNet(parse_context, yystack_[12].value.as < euler::Symbol > ()), yystack_[8].value.as < double > (), yystack_[4].value.as < double > ());
     yylhs.value.as < std::shared_ptr<euler::Mos> > ()->RegisterToConnections();
   }
-#line 710 "y.tab.cc"
+#line 698 "y.tab.cc"
     break;
 
 
-#line 714 "y.tab.cc"
+#line 702 "y.tab.cc"
 
             default:
               break;
@@ -727,7 +715,6 @@ namespace yy {
       YY_SYMBOL_PRINT ("-> $$ =", yylhs);
       yypop_ (yylen);
       yylen = 0;
-      YY_STACK_PRINT ();
 
       // Shift the result of the reduction.
       yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
@@ -743,7 +730,9 @@ namespace yy {
     if (!yyerrstatus_)
       {
         ++yynerrs_;
-        error (yysyntax_error_ (yystack_[0].state, yyla));
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (YY_MOVE (msg));
       }
 
 
@@ -753,7 +742,7 @@ namespace yy {
            error, discard it.  */
 
         // Return failure if at end of input.
-        if (yyla.type_get () == yyeof_)
+        if (yyla.kind () == symbol_kind::S_YYEOF)
           YYABORT;
         else if (!yyla.empty ())
           {
@@ -779,6 +768,7 @@ namespace yy {
        this YYERROR.  */
     yypop_ (yylen);
     yylen = 0;
+    YY_STACK_PRINT ();
     goto yyerrlab1;
 
 
@@ -787,30 +777,32 @@ namespace yy {
   `-------------------------------------------------------------*/
   yyerrlab1:
     yyerrstatus_ = 3;   // Each real token shifted decrements this.
-    {
-      stack_symbol_type error_token;
-      for (;;)
-        {
-          yyn = yypact_[+yystack_[0].state];
-          if (!yy_pact_value_is_default_ (yyn))
-            {
-              yyn += yy_error_token_;
-              if (0 <= yyn && yyn <= yylast_ && yycheck_[yyn] == yy_error_token_)
-                {
-                  yyn = yytable_[yyn];
-                  if (0 < yyn)
-                    break;
-                }
-            }
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
+              {
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
+              }
+          }
 
-          // Pop the current state because it cannot handle the error token.
-          if (yystack_.size () == 1)
-            YYABORT;
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
 
-          yy_destroy_ ("Error: popping", yystack_[0]);
-          yypop_ ();
-          YY_STACK_PRINT ();
-        }
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
+      }
+    {
+      stack_symbol_type error_token;
 
 
       // Shift the error token.
@@ -847,6 +839,7 @@ namespace yy {
     /* Do not reclaim the symbols of the rule whose action triggered
        this YYABORT or YYACCEPT.  */
     yypop_ (yylen);
+    YY_STACK_PRINT ();
     while (1 < yystack_.size ())
       {
         yy_destroy_ ("Cleanup: popping", yystack_[0]);
@@ -880,15 +873,105 @@ namespace yy {
     error (yyexc.what ());
   }
 
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
+  std::string
+  parser::yytnamerr_ (const char *yystr)
+  {
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
+
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
+
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+#if YYDEBUG
+    // Execute LAC once. We don't care if it is successful, we
+    // only do it for the sake of debugging output.
+    if (!yyparser_.yy_lac_established_)
+      yyparser_.yy_lac_check_ (yyla_.kind ());
+#endif
+
+    for (int yyx = 0; yyx < YYNTOKENS; ++yyx)
+      {
+        symbol_kind_type yysym = YY_CAST (symbol_kind_type, yyx);
+        if (yysym != symbol_kind::S_YYerror
+            && yysym != symbol_kind::S_YYUNDEF
+            && yyparser_.yy_lac_check_ (yysym))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = yysym;
+          }
+      }
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
+
+
   bool
-  parser::yy_lac_check_ (int yytoken) const
+  parser::yy_lac_check_ (symbol_kind_type yytoken) const
   {
     // Logically, the yylac_stack's lifetime is confined to this function.
     // Clear it, to get rid of potential left-overs from previous call.
     yylac_stack_.clear ();
     // Reduce until we encounter a shift and thereby accept the token.
 #if YYDEBUG
-    YYCDEBUG << "LAC: checking lookahead " << yytname_[yytoken] << ':';
+    YYCDEBUG << "LAC: checking lookahead " << symbol_name (yytoken) << ':';
 #endif
     std::ptrdiff_t lac_top = 0;
     while (true)
@@ -952,14 +1035,14 @@ namespace yy {
                      : yylac_stack_.back ());
         // Push the resulting state of the reduction.
         state_type state = yy_lr_goto_state_ (top_state, yyr1_[yyrule]);
-        YYCDEBUG << " G" << state;
+        YYCDEBUG << " G" << int (state);
         yylac_stack_.push_back (state);
       }
   }
 
   // Establish the initial context if no initial context currently exists.
   bool
-  parser::yy_lac_establish_ (int yytoken)
+  parser::yy_lac_establish_ (symbol_kind_type yytoken)
   {
     /* Establish the initial context for the current lookahead if no initial
        context is currently established.
@@ -984,21 +1067,22 @@ namespace yy {
        follows.  If no initial context is currently established for the
        current lookahead, then check if that lookahead can eventually be
        shifted if syntactic actions continue from the current context.  */
-    if (!yy_lac_established_)
+    if (yy_lac_established_)
+      return true;
+    else
       {
 #if YYDEBUG
         YYCDEBUG << "LAC: initial context established for "
-                 << yytname_[yytoken] << '\n';
+                 << symbol_name (yytoken) << '\n';
 #endif
         yy_lac_established_ = true;
         return yy_lac_check_ (yytoken);
       }
-    return true;
   }
 
   // Discard any previous initial lookahead context.
   void
-  parser::yy_lac_discard_ (const char* evt)
+  parser::yy_lac_discard_ (const char* event)
   {
    /* Discard any previous initial lookahead context because of Event,
       which may be a lookahead change or an invalidation of the currently
@@ -1014,23 +1098,16 @@ namespace yy {
     if (yy_lac_established_)
       {
         YYCDEBUG << "LAC: initial context discarded due to "
-                 << evt << '\n';
+                 << event << '\n';
         yy_lac_established_ = false;
       }
   }
 
-  // Generate an error message.
-  std::string
-  parser::yysyntax_error_ (state_type yystate, const symbol_type& yyla) const
-  {
-    // Number of reported tokens (one for the "unexpected", one per
-    // "expected").
-    std::ptrdiff_t yycount = 0;
-    // Its maximum.
-    enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-    // Arguments of yyformat.
-    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
 
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
     /* There are many possibilities here to consider:
        - If this state is a consistent state with a default action, then
          the only way this function was invoked is if the default action
@@ -1053,35 +1130,26 @@ namespace yy {
          initial context during error recovery, leaving behind the
          current lookahead.
     */
-    if (!yyla.empty ())
-      {
-        symbol_number_type yytoken = yyla.type_get ();
-        yyarg[yycount++] = yytname_[yytoken];
 
-#if YYDEBUG
-        // Execute LAC once. We don't care if it is succesful, we
-        // only do it for the sake of debugging output.
-        if (!yy_lac_established_)
-          yy_lac_check_ (yytoken);
-#endif
-
-        int yyn = yypact_[+yystate];
-        if (!yy_pact_value_is_default_ (yyn))
-          {
-            for (int yyx = 0; yyx < yyntokens_; ++yyx)
-              if (yyx != yy_error_token_ && yyx != yy_undef_token_
-                  && yy_lac_check_ (yyx))
-                {
-                  if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                    {
-                      yycount = 1;
-                      break;
-                    }
-                  else
-                    yyarg[yycount++] = yytname_[yyx];
-                }
-          }
+    if (!yyctx.lookahead ().empty ())
+      {
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
       }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
 
     char const* yyformat = YY_NULLPTR;
     switch (yycount)
@@ -1106,7 +1174,7 @@ namespace yy {
     for (char const* yyp = yyformat; *yyp; ++yyp)
       if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
         {
-          yyres += yytnamerr_ (yyarg[yyi++]);
+          yyres += symbol_name (yyarg[yyi++]);
           ++yyp;
         }
       else
@@ -1122,94 +1190,99 @@ namespace yy {
   const signed char
   parser::yypact_[] =
   {
-      -1,    -6,     5,    -3,   -10,   -10,    -9,   -10,    -2,     0,
-       1,    -4,     2,   -10,   -10,     3,     4,   -10,     6,    12,
-      10,     7,     8,    15,    16,     9,    13,    19,    17,    14,
-      18,   -10
+       1,    -5,     6,    -1,   -10,     0,   -10,   -10,    -3,   -10,
+     -10,    -9,   -10,   -10,   -10,     2,     3,    -2,     4,     5,
+     -10,     7,   -10,     8,   -10,    10,     9,    13,    -6,    11,
+      17,    18,    14,    15,    22,    20,    19,    23,   -10
   };
 
   const signed char
   parser::yydefact_[] =
   {
-       0,     0,     0,     0,     1,     4,     0,     3,     0,     0,
-       0,     0,     0,     6,     2,     0,     0,     5,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     7
+       0,     0,     0,     7,     4,     0,     1,     6,     8,     2,
+      11,     0,     5,     3,    10,     0,     0,     0,     0,     0,
+       9,     0,    13,     0,    12,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    14
   };
 
   const signed char
   parser::yypgoto_[] =
   {
-     -10,   -10,    20,   -10,   -10
+     -10,   -10,   -10,   -10,   -10,    16,   -10,   -10,    21
   };
 
   const signed char
   parser::yydefgoto_[] =
   {
-      -1,     2,    10,    11,     6
+       0,     2,     3,     8,     9,     4,    11,    17,    18
   };
 
   const signed char
   parser::yytable_[] =
   {
-      14,     7,     1,     8,     3,     4,     9,     5,     9,     0,
-      12,     0,    16,    13,    18,    17,    19,    20,    21,    23,
-      22,    24,    26,    25,    27,    28,    29,    30,     0,    31,
-       0,    15
+       1,    14,    20,    15,     1,     5,     6,    29,    16,    12,
+      10,     7,    16,    19,    27,    23,    22,     0,    25,    24,
+      26,    28,    30,    31,    13,    32,    34,    33,    35,    36,
+       0,     0,    37,     0,    38,     0,     0,     0,    21
   };
 
   const signed char
   parser::yycheck_[] =
   {
-       4,    10,     3,    12,    10,     0,    10,    10,    10,    -1,
-      10,    -1,    10,    12,    10,    12,    10,     5,     8,    11,
-      13,     6,    13,     7,    11,     6,     9,    13,    -1,    11,
-      -1,    11
+       3,    10,     4,    12,     3,    10,     0,    13,    10,    12,
+      10,    12,    10,    10,     5,    10,    12,    -1,    10,    12,
+      10,     8,    11,     6,     8,     7,    11,    13,     6,     9,
+      -1,    -1,    13,    -1,    11,    -1,    -1,    -1,    17
   };
 
   const signed char
   parser::yystos_[] =
   {
-       0,     3,    15,    10,     0,    10,    18,    10,    12,    10,
-      16,    17,    10,    12,     4,    16,    10,    12,    10,    10,
-       5,     8,    13,    11,     6,     7,    13,    11,     6,     9,
-      13,    11
+       0,     3,    15,    16,    19,    10,     0,    12,    17,    18,
+      10,    20,    12,    19,    10,    12,    10,    21,    22,    10,
+       4,    22,    12,    10,    12,    10,    10,     5,     8,    13,
+      11,     6,     7,    13,    11,     6,     9,    13,    11
   };
 
   const signed char
   parser::yyr1_[] =
   {
-       0,    14,    15,    18,    18,    17,    17,    16
+       0,    14,    15,    16,    16,    17,    17,    18,    18,    19,
+      20,    20,    21,    21,    22
   };
 
   const signed char
   parser::yyr2_[] =
   {
-       0,     2,     6,     2,     1,     3,     2,    17
+       0,     2,     2,     3,     1,     2,     1,     0,     1,     6,
+       2,     1,     3,     2,    17
   };
 
 
-
+#if YYDEBUG || 1
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-  // First, the terminals, then, starting at \a yyntokens_, nonterminals.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
   const char*
   const parser::yytname_[] =
   {
-  "EOF", "error", "$undefined", "SUBCKT", "ENDS", "MOS_TYPE", "UNIT",
-  "LENGTH", "WIDTH", "NFIN", "NAME", "NUMBER", "EOL", "'='", "$accept",
-  "circuit", "mos", "mos_list", "net_list", YY_NULLPTR
+  "EOF", "error", "\"invalid token\"", "SUBCKT", "ENDS", "MOS_TYPE",
+  "UNIT", "LENGTH", "WIDTH", "NFIN", "NAME", "NUMBER", "EOL", "'='",
+  "$accept", "library", "circuit_list", "eol_list", "opt_eol_list",
+  "circuit", "net_list", "mos_list", "mos", YY_NULLPTR
   };
+#endif
+
 
 #if YYDEBUG
-  const signed char
+  const unsigned char
   parser::yyrline_[] =
   {
-       0,    74,    74,    82,    86,    93,    97,   103
+       0,   101,   101,   105,   106,   110,   111,   115,   116,   120,
+     137,   141,   148,   152,   158
   };
 
-  // Print the state stack on the debug stream.
   void
-  parser::yystack_print_ ()
+  parser::yy_stack_print_ () const
   {
     *yycdebug_ << "Stack now";
     for (stack_type::const_iterator
@@ -1220,9 +1293,8 @@ namespace yy {
     *yycdebug_ << '\n';
   }
 
-  // Report on the debug stream that the rule \a yyrule is going to be reduced.
   void
-  parser::yy_reduce_print_ (int yyrule)
+  parser::yy_reduce_print_ (int yyrule) const
   {
     int yylno = yyrline_[yyrule];
     int yynrhs = yyr2_[yyrule];
@@ -1238,32 +1310,50 @@ namespace yy {
 
 
 } // yy
-#line 1242 "y.tab.cc"
+#line 1314 "y.tab.cc"
+
+#line 172 "parser.y"
 
-#line 112 "parser.y"
 
+std::optional<std::vector<euler::Circuit>> euler::Parse(std::istream& in) {
+  auto scanner = Scanner{in};
+  auto context = ParseContext{};
+  auto parser = yy::parser{scanner, context};
+  // 0 on success, 1 otherwise
+  if (parser.parse()) {
+    return std::nullopt;
+  }
+  return std::move(context.circuits);
+}
 
 void yy::parser::error(const std::string& err) {
-  std::cerr << err << std::endl;
+  std::cerr << "line " << scanner.LineNo() << ": " << err << std::endl;
+}
+
+static yy::parser::symbol_type yylex(euler::Scanner& scanner) {
+  return scanner.Lex();
 }
 
-static std::shared_ptr<euler::Net> GetOrCreateNet(const std::string& name) {
-    auto net = GetNetOrNull(name);
+static std::shared_ptr<euler::Net> GetOrCreateNet(
+    euler::ParseContext& context, euler::Symbol name) {
+    auto net = GetNetOrNull(context, name);
     if (!net) {
         net = std::make_shared<euler::Net>(name);
-        RegisterNet(net);
+        RegisterNet(context, net);
     }
     return net;
 }
 
-static std::shared_ptr<euler::Net> GetNetOrNull(const std::string& name) {
-  if (auto net = nets.find(name); net == nets.cend()) {
+static std::shared_ptr<euler::Net> GetNetOrNull(
+    const euler::ParseContext& context, euler::Symbol name) {
+  if (auto net = context.nets.find(name); net == context.nets.cend()) {
     return nullptr;
   } else {
     return net->second;
   }
 }
 
-static void RegisterNet(std::shared_ptr<euler::Net> net) {
-  nets.emplace(net->GetName(), net);
+static void RegisterNet(euler::ParseContext& context,
+                        std::shared_ptr<euler::Net> net) {
+  context.nets.emplace(net->GetSymbol(), net);
 }
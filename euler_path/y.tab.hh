@@ -1,8 +1,8 @@
-// A Bison parser, made by GNU Bison 3.5.1.
+// A Bison parser, made by GNU Bison 3.8.2.
 
 // Skeleton interface for Bison LALR(1) parsers in C++
 
-// Copyright (C) 2002-2015, 2018-2020 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -15,7 +15,7 @@
 // GNU General Public License for more details.
 
 // You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // As a special exception, you may create a larger work that contains
 // part or all of the Bison parser skeleton and distribute that work
@@ -38,23 +38,39 @@
 
 // C++ LALR(1) parser skeleton written by Akim Demaille.
 
-// Undocumented macros, especially those whose name start with YY_,
-// are private implementation details.  Do not rely on them.
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
 #ifndef YY_YY_Y_TAB_HH_INCLUDED
 # define YY_YY_Y_TAB_HH_INCLUDED
 // "%code requires" blocks.
-#line 26 "parser.y"
+#line 7 "parser.y"
 
 #include <memory>
-#include <string>
-#include <utility>
+#include <unordered_map>
 #include <vector>
 
 #include "circuit.h"
 #include "mos.h"
+#include "symbol.h"
 
-#line 58 "y.tab.hh"
+namespace euler {
+
+class Scanner;
+
+/// @brief The states of a single parse. Nothing is shared across parses, so
+/// multiple netlists can be parsed at once.
+struct ParseContext {
+  /// @note In the order of the input.
+  std::vector<Circuit> circuits;
+  /// @brief The nets of the circuit being parsed.
+  std::unordered_map<Symbol, std::shared_ptr<Net>> nets;
+};
+
+}  // namespace euler
+
+#line 74 "y.tab.hh"
 
 # include <cassert>
 # include <cstdlib> // std::abort
@@ -125,17 +141,23 @@
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -188,7 +210,7 @@
 #endif
 
 namespace yy {
-#line 192 "y.tab.hh"
+#line 214 "y.tab.hh"
 
 
 
@@ -197,35 +219,47 @@ namespace yy {
   class parser
   {
   public:
-#ifndef YYSTYPE
+#ifdef YYSTYPE
+# ifdef __GNUC__
+#  pragma GCC message "bison: do not #define YYSTYPE in C++, use %define api.value.type"
+# endif
+    typedef YYSTYPE value_type;
+#else
   /// A buffer to store and retrieve objects.
   ///
   /// Sort of a variant, but does not keep track of the nature
   /// of the stored data, since that knowledge is available
   /// via the current parser state.
-  class semantic_type
+  class value_type
   {
   public:
     /// Type of *this.
-    typedef semantic_type self_type;
+    typedef value_type self_type;
 
     /// Empty construction.
-    semantic_type () YY_NOEXCEPT
-      : yybuffer_ ()
+    value_type () YY_NOEXCEPT
+      : yyraw_ ()
       , yytypeid_ (YY_NULLPTR)
     {}
 
     /// Construct and fill.
     template <typename T>
-    semantic_type (YY_RVREF (T) t)
+    value_type (YY_RVREF (T) t)
       : yytypeid_ (&typeid (T))
     {
       YY_ASSERT (sizeof (T) <= size);
       new (yyas_<T> ()) T (YY_MOVE (t));
     }
 
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    value_type (const self_type&) = delete;
+    /// Non copyable.
+    self_type& operator= (const self_type&) = delete;
+#endif
+
     /// Destruction, allowed only if empty.
-    ~semantic_type () YY_NOEXCEPT
+    ~value_type () YY_NOEXCEPT
     {
       YY_ASSERT (!yytypeid_);
     }
@@ -367,16 +401,19 @@ namespace yy {
     }
 
   private:
-    /// Prohibit blind copies.
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
+    value_type (const self_type&);
+    /// Non copyable.
     self_type& operator= (const self_type&);
-    semantic_type (const self_type&);
+#endif
 
     /// Accessor to raw memory as \a T.
     template <typename T>
     T*
     yyas_ () YY_NOEXCEPT
     {
-      void *yyp = yybuffer_.yyraw;
+      void *yyp = yyraw_;
       return static_cast<T*> (yyp);
      }
 
@@ -385,7 +422,7 @@ namespace yy {
     const T*
     yyas_ () const YY_NOEXCEPT
     {
-      const void *yyp = yybuffer_.yyraw;
+      const void *yyp = yyraw_;
       return static_cast<const T*> (yyp);
      }
 
@@ -398,11 +435,11 @@ namespace yy {
       // MOS_TYPE
       char dummy2[sizeof (euler::Mos::Type)];
 
-      // mos
-      char dummy3[sizeof (std::shared_ptr<euler::Mos>)];
-
       // NAME
-      char dummy4[sizeof (std::string)];
+      char dummy3[sizeof (euler::Symbol)];
+
+      // mos
+      char dummy4[sizeof (std::shared_ptr<euler::Mos>)];
 
       // mos_list
       char dummy5[sizeof (std::vector<std::shared_ptr<euler::Mos>>)];
@@ -415,18 +452,19 @@ namespace yy {
     union
     {
       /// Strongest alignment constraints.
-      long double yyalign_me;
+      long double yyalign_me_;
       /// A buffer large enough to store any of the semantic values.
-      char yyraw[size];
-    } yybuffer_;
+      char yyraw_[size];
+    };
 
     /// Whether the content is built: if defined, the name of the stored type.
     const std::type_info *yytypeid_;
   };
 
-#else
-    typedef YYSTYPE semantic_type;
 #endif
+    /// Backward compatibility (Bison 3.8).
+    typedef value_type semantic_type;
+
 
     /// Syntax errors thrown from user actions.
     struct syntax_error : std::runtime_error
@@ -442,41 +480,79 @@ namespace yy {
       ~syntax_error () YY_NOEXCEPT YY_NOTHROW;
     };
 
-    /// Tokens.
+    /// Token kinds.
     struct token
     {
-      enum yytokentype
+      enum token_kind_type
       {
-        TOK_EOF = 0,
-        TOK_SUBCKT = 258,
-        TOK_ENDS = 259,
-        TOK_MOS_TYPE = 260,
-        TOK_UNIT = 261,
-        TOK_LENGTH = 262,
-        TOK_WIDTH = 263,
-        TOK_NFIN = 264,
-        TOK_NAME = 265,
-        TOK_NUMBER = 266,
-        TOK_EOL = 267
+        TOK_YYEMPTY = -2,
+    TOK_EOF = 0,                   // EOF
+    TOK_YYerror = 256,             // error
+    TOK_YYUNDEF = 257,             // "invalid token"
+    TOK_SUBCKT = 258,              // SUBCKT
+    TOK_ENDS = 259,                // ENDS
+    TOK_MOS_TYPE = 260,            // MOS_TYPE
+    TOK_UNIT = 261,                // UNIT
+    TOK_LENGTH = 262,              // LENGTH
+    TOK_WIDTH = 263,               // WIDTH
+    TOK_NFIN = 264,                // NFIN
+    TOK_NAME = 265,                // NAME
+    TOK_NUMBER = 266,              // NUMBER
+    TOK_EOL = 267                  // EOL
       };
+      /// Backward compatibility alias (Bison 3.6).
+      typedef token_kind_type yytokentype;
     };
 
-    /// (External) token type, as returned by yylex.
-    typedef token::yytokentype token_type;
+    /// Token kind, as returned by yylex.
+    typedef token::token_kind_type token_kind_type;
+
+    /// Backward compatibility alias (Bison 3.6).
+    typedef token_kind_type token_type;
 
-    /// Symbol type: an internal symbol number.
-    typedef int symbol_number_type;
+    /// Symbol kinds.
+    struct symbol_kind
+    {
+      enum symbol_kind_type
+      {
+        YYNTOKENS = 14, ///< Number of tokens.
+        S_YYEMPTY = -2,
+        S_YYEOF = 0,                             // EOF
+        S_YYerror = 1,                           // error
+        S_YYUNDEF = 2,                           // "invalid token"
+        S_SUBCKT = 3,                            // SUBCKT
+        S_ENDS = 4,                              // ENDS
+        S_MOS_TYPE = 5,                          // MOS_TYPE
+        S_UNIT = 6,                              // UNIT
+        S_LENGTH = 7,                            // LENGTH
+        S_WIDTH = 8,                             // WIDTH
+        S_NFIN = 9,                              // NFIN
+        S_NAME = 10,                             // NAME
+        S_NUMBER = 11,                           // NUMBER
+        S_EOL = 12,                              // EOL
+        S_13_ = 13,                              // '='
+        S_YYACCEPT = 14,                         // $accept
+        S_library = 15,                          // library
+        S_circuit_list = 16,                     // circuit_list
+        S_eol_list = 17,                         // eol_list
+        S_opt_eol_list = 18,                     // opt_eol_list
+        S_circuit = 19,                          // circuit
+        S_net_list = 20,                         // net_list
+        S_mos_list = 21,                         // mos_list
+        S_mos = 22                               // mos
+      };
+    };
 
-    /// The symbol type number to denote an empty symbol.
-    enum { empty_symbol = -2 };
+    /// (Internal) symbol kind.
+    typedef symbol_kind::symbol_kind_type symbol_kind_type;
 
-    /// Internal symbol number for tokens (subsumed by symbol_number_type).
-    typedef signed char token_number_type;
+    /// The number of tokens.
+    static const symbol_kind_type YYNTOKENS = symbol_kind::YYNTOKENS;
 
     /// A complete symbol.
     ///
-    /// Expects its Base type to provide access to the symbol type
-    /// via type_get ().
+    /// Expects its Base type to provide access to the symbol kind
+    /// via kind ().
     ///
     /// Provide access to semantic value.
     template <typename Base>
@@ -486,19 +562,49 @@ namespace yy {
       typedef Base super_type;
 
       /// Default constructor.
-      basic_symbol ()
+      basic_symbol () YY_NOEXCEPT
         : value ()
       {}
 
 #if 201103L <= YY_CPLUSPLUS
       /// Move constructor.
-      basic_symbol (basic_symbol&& that);
+      basic_symbol (basic_symbol&& that)
+        : Base (std::move (that))
+        , value ()
+      {
+        switch (this->kind ())
+    {
+      case symbol_kind::S_NUMBER: // NUMBER
+        value.move< double > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
+        value.move< euler::Mos::Type > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_NAME: // NAME
+        value.move< euler::Symbol > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_mos: // mos
+        value.move< std::shared_ptr<euler::Mos> > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_mos_list: // mos_list
+        value.move< std::vector<std::shared_ptr<euler::Mos>> > (std::move (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+      }
 #endif
 
       /// Copy constructor.
       basic_symbol (const basic_symbol& that);
 
-      /// Constructor for valueless symbols, and symbols from each type.
+      /// Constructors for typed symbols.
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t)
         : Base (t)
@@ -508,6 +614,7 @@ namespace yy {
         : Base (t)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, double&& v)
         : Base (t)
@@ -519,6 +626,7 @@ namespace yy {
         , value (v)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, euler::Mos::Type&& v)
         : Base (t)
@@ -530,28 +638,31 @@ namespace yy {
         , value (v)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
-      basic_symbol (typename Base::kind_type t, std::shared_ptr<euler::Mos>&& v)
+      basic_symbol (typename Base::kind_type t, euler::Symbol&& v)
         : Base (t)
         , value (std::move (v))
       {}
 #else
-      basic_symbol (typename Base::kind_type t, const std::shared_ptr<euler::Mos>& v)
+      basic_symbol (typename Base::kind_type t, const euler::Symbol& v)
         : Base (t)
         , value (v)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
-      basic_symbol (typename Base::kind_type t, std::string&& v)
+      basic_symbol (typename Base::kind_type t, std::shared_ptr<euler::Mos>&& v)
         : Base (t)
         , value (std::move (v))
       {}
 #else
-      basic_symbol (typename Base::kind_type t, const std::string& v)
+      basic_symbol (typename Base::kind_type t, const std::shared_ptr<euler::Mos>& v)
         : Base (t)
         , value (v)
       {}
 #endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, std::vector<std::shared_ptr<euler::Mos>>&& v)
         : Base (t)
@@ -570,39 +681,41 @@ namespace yy {
         clear ();
       }
 
+
+
       /// Destroy contents, and record that is empty.
-      void clear ()
+      void clear () YY_NOEXCEPT
       {
         // User destructor.
-        symbol_number_type yytype = this->type_get ();
+        symbol_kind_type yykind = this->kind ();
         basic_symbol<Base>& yysym = *this;
         (void) yysym;
-        switch (yytype)
+        switch (yykind)
         {
        default:
           break;
         }
 
-        // Type destructor.
-switch (yytype)
+        // Value type destructor.
+switch (yykind)
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.template destroy< double > ();
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.template destroy< euler::Mos::Type > ();
         break;
 
-      case 16: // mos
-        value.template destroy< std::shared_ptr<euler::Mos> > ();
+      case symbol_kind::S_NAME: // NAME
+        value.template destroy< euler::Symbol > ();
         break;
 
-      case 10: // NAME
-        value.template destroy< std::string > ();
+      case symbol_kind::S_mos: // mos
+        value.template destroy< std::shared_ptr<euler::Mos> > ();
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.template destroy< std::vector<std::shared_ptr<euler::Mos>> > ();
         break;
 
@@ -613,6 +726,15 @@ switch (yytype)
         Base::clear ();
       }
 
+      /// The user-facing name of this symbol.
+      std::string name () const YY_NOEXCEPT
+      {
+        return parser::symbol_name (this->kind ());
+      }
+
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
+
       /// Whether empty.
       bool empty () const YY_NOEXCEPT;
 
@@ -620,7 +742,7 @@ switch (yytype)
       void move (basic_symbol& s);
 
       /// The semantic value.
-      semantic_type value;
+      value_type value;
 
     private:
 #if YY_CPLUSPLUS < 201103L
@@ -630,109 +752,123 @@ switch (yytype)
     };
 
     /// Type access provider for token (enum) based symbols.
-    struct by_type
+    struct by_kind
     {
+      /// The symbol kind as needed by the constructor.
+      typedef token_kind_type kind_type;
+
       /// Default constructor.
-      by_type ();
+      by_kind () YY_NOEXCEPT;
 
 #if 201103L <= YY_CPLUSPLUS
       /// Move constructor.
-      by_type (by_type&& that);
+      by_kind (by_kind&& that) YY_NOEXCEPT;
 #endif
 
       /// Copy constructor.
-      by_type (const by_type& that);
-
-      /// The symbol type as needed by the constructor.
-      typedef token_type kind_type;
+      by_kind (const by_kind& that) YY_NOEXCEPT;
 
       /// Constructor from (external) token numbers.
-      by_type (kind_type t);
+      by_kind (kind_type t) YY_NOEXCEPT;
+
+
 
       /// Record that this symbol is empty.
-      void clear ();
+      void clear () YY_NOEXCEPT;
 
-      /// Steal the symbol type from \a that.
-      void move (by_type& that);
+      /// Steal the symbol kind from \a that.
+      void move (by_kind& that);
 
       /// The (internal) type number (corresponding to \a type).
       /// \a empty when empty.
-      symbol_number_type type_get () const YY_NOEXCEPT;
+      symbol_kind_type kind () const YY_NOEXCEPT;
+
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
 
-      /// The symbol type.
-      /// \a empty_symbol when empty.
-      /// An int, not token_number_type, to be able to store empty_symbol.
-      int type;
+      /// The symbol kind.
+      /// \a S_YYEMPTY when empty.
+      symbol_kind_type kind_;
     };
 
+    /// Backward compatibility for a private implementation detail (Bison 3.6).
+    typedef by_kind by_type;
+
     /// "External" symbols: returned by the scanner.
-    struct symbol_type : basic_symbol<by_type>
+    struct symbol_type : basic_symbol<by_kind>
     {
       /// Superclass.
-      typedef basic_symbol<by_type> super_type;
+      typedef basic_symbol<by_kind> super_type;
 
       /// Empty symbol.
-      symbol_type () {}
+      symbol_type () YY_NOEXCEPT {}
 
       /// Constructor for valueless symbols, and symbols from each type.
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok)
-        : super_type(token_type (tok))
-      {
-        YY_ASSERT (tok == token::TOK_EOF || tok == token::TOK_SUBCKT || tok == token::TOK_ENDS || tok == token::TOK_UNIT || tok == token::TOK_LENGTH || tok == token::TOK_WIDTH || tok == token::TOK_NFIN || tok == token::TOK_EOL || tok == 61);
-      }
+        : super_type (token_kind_type (tok))
 #else
       symbol_type (int tok)
-        : super_type(token_type (tok))
+        : super_type (token_kind_type (tok))
+#endif
       {
-        YY_ASSERT (tok == token::TOK_EOF || tok == token::TOK_SUBCKT || tok == token::TOK_ENDS || tok == token::TOK_UNIT || tok == token::TOK_LENGTH || tok == token::TOK_WIDTH || tok == token::TOK_NFIN || tok == token::TOK_EOL || tok == 61);
-      }
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::TOK_EOF
+                   || (token::TOK_YYerror <= tok && tok <= token::TOK_ENDS)
+                   || (token::TOK_UNIT <= tok && tok <= token::TOK_NFIN)
+                   || tok == token::TOK_EOL
+                   || tok == 61);
 #endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, double v)
-        : super_type(token_type (tok), std::move (v))
-      {
-        YY_ASSERT (tok == token::TOK_NUMBER);
-      }
+        : super_type (token_kind_type (tok), std::move (v))
 #else
       symbol_type (int tok, const double& v)
-        : super_type(token_type (tok), v)
+        : super_type (token_kind_type (tok), v)
+#endif
       {
+#if !defined _MSC_VER || defined __clang__
         YY_ASSERT (tok == token::TOK_NUMBER);
-      }
 #endif
+      }
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, euler::Mos::Type v)
-        : super_type(token_type (tok), std::move (v))
-      {
-        YY_ASSERT (tok == token::TOK_MOS_TYPE);
-      }
+        : super_type (token_kind_type (tok), std::move (v))
 #else
       symbol_type (int tok, const euler::Mos::Type& v)
-        : super_type(token_type (tok), v)
+        : super_type (token_kind_type (tok), v)
+#endif
       {
+#if !defined _MSC_VER || defined __clang__
         YY_ASSERT (tok == token::TOK_MOS_TYPE);
-      }
 #endif
-#if 201103L <= YY_CPLUSPLUS
-      symbol_type (int tok, std::string v)
-        : super_type(token_type (tok), std::move (v))
-      {
-        YY_ASSERT (tok == token::TOK_NAME);
       }
+#if 201103L <= YY_CPLUSPLUS
+      symbol_type (int tok, euler::Symbol v)
+        : super_type (token_kind_type (tok), std::move (v))
 #else
-      symbol_type (int tok, const std::string& v)
-        : super_type(token_type (tok), v)
+      symbol_type (int tok, const euler::Symbol& v)
+        : super_type (token_kind_type (tok), v)
+#endif
       {
+#if !defined _MSC_VER || defined __clang__
         YY_ASSERT (tok == token::TOK_NAME);
-      }
 #endif
+      }
     };
 
     /// Build a parser object.
-    parser ();
+    parser (euler::Scanner& scanner_yyarg, euler::ParseContext& parse_context_yyarg);
     virtual ~parser ();
 
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    parser (const parser&) = delete;
+    /// Non copyable.
+    parser& operator= (const parser&) = delete;
+#endif
+
     /// Parse.  An alias for parse ().
     /// \returns  0 iff parsing succeeded.
     int operator() ();
@@ -762,7 +898,11 @@ switch (yytype)
     /// Report a syntax error.
     void error (const syntax_error& err);
 
-    // Implementation of make_symbol for each symbol type.
+    /// The user-facing name of the symbol whose (internal) number is
+    /// YYSYMBOL.  No bounds checking.
+    static std::string symbol_name (symbol_kind_type yysymbol);
+
+    // Implementation of make_symbol for each token kind.
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -778,6 +918,36 @@ switch (yytype)
         return symbol_type (token::TOK_EOF);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYerror ()
+      {
+        return symbol_type (token::TOK_YYerror);
+      }
+#else
+      static
+      symbol_type
+      make_YYerror ()
+      {
+        return symbol_type (token::TOK_YYerror);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYUNDEF ()
+      {
+        return symbol_type (token::TOK_YYUNDEF);
+      }
+#else
+      static
+      symbol_type
+      make_YYUNDEF ()
+      {
+        return symbol_type (token::TOK_YYUNDEF);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -886,14 +1056,14 @@ switch (yytype)
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_NAME (std::string v)
+      make_NAME (euler::Symbol v)
       {
         return symbol_type (token::TOK_NAME, std::move (v));
       }
 #else
       static
       symbol_type
-      make_NAME (const std::string& v)
+      make_NAME (const euler::Symbol& v)
       {
         return symbol_type (token::TOK_NAME, v);
       }
@@ -930,17 +1100,36 @@ switch (yytype)
 #endif
 
 
+    class context
+    {
+    public:
+      context (const parser& yyparser, const symbol_type& yyla);
+      const symbol_type& lookahead () const YY_NOEXCEPT { return yyla_; }
+      symbol_kind_type token () const YY_NOEXCEPT { return yyla_.kind (); }
+      /// Put in YYARG at most YYARGN of the expected tokens, and return the
+      /// number of tokens stored in YYARG.  If YYARG is null, return the
+      /// number of expected tokens (guaranteed to be less than YYNTOKENS).
+      int expected_tokens (symbol_kind_type yyarg[], int yyargn) const;
+
+    private:
+      const parser& yyparser_;
+      const symbol_type& yyla_;
+    };
+
   private:
-    /// This class is not copyable.
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
     parser (const parser&);
+    /// Non copyable.
     parser& operator= (const parser&);
+#endif
 
     /// Check the lookahead yytoken.
     /// \returns  true iff the token will be eventually shifted.
-    bool yy_lac_check_ (int yytoken) const;
+    bool yy_lac_check_ (symbol_kind_type yytoken) const;
     /// Establish the initial context if no initial context currently exists.
     /// \returns  true iff the token will be eventually shifted.
-    bool yy_lac_establish_ (int yytoken);
+    bool yy_lac_establish_ (symbol_kind_type yytoken);
     /// Discard any previous initial lookahead context because of event.
     /// \param event  the event which caused the lookahead to be discarded.
     ///               Only used for debbuging output.
@@ -949,12 +1138,13 @@ switch (yytype)
     /// Stored state numbers (used for stacks).
     typedef signed char state_type;
 
-    /// Generate an error message.
-    /// \param yystate   the state where the error occurred.
-    /// \param yyla      the lookahead token.
-    virtual std::string yysyntax_error_ (state_type yystate,
-                                         const symbol_type& yyla) const;
+    /// The arguments of the error message.
+    int yy_syntax_error_arguments_ (const context& yyctx,
+                                    symbol_kind_type yyarg[], int yyargn) const;
 
+    /// Generate an error message.
+    /// \param yyctx     the context in which the error occurred.
+    virtual std::string yysyntax_error_ (const context& yyctx) const;
     /// Compute post-reduction state.
     /// \param yystate   the current state
     /// \param yysym     the nonterminal to push on the stack
@@ -962,19 +1152,26 @@ switch (yytype)
 
     /// Whether the given \c yypact_ value indicates a defaulted state.
     /// \param yyvalue   the value to check
-    static bool yy_pact_value_is_default_ (int yyvalue);
+    static bool yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT;
 
     /// Whether the given \c yytable_ value indicates a syntax error.
     /// \param yyvalue   the value to check
-    static bool yy_table_value_is_error_ (int yyvalue);
+    static bool yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT;
 
     static const signed char yypact_ninf_;
     static const signed char yytable_ninf_;
 
-    /// Convert a scanner token number \a t to a symbol number.
-    /// In theory \a t should be a token_type, but character literals
-    /// are valid, yet not members of the token_type enum.
-    static token_number_type yytranslate_ (int t);
+    /// Convert a scanner token kind \a t to a symbol kind.
+    /// In theory \a t should be a token_kind_type, but character literals
+    /// are valid, yet not members of the token_kind_type enum.
+    static symbol_kind_type yytranslate_ (int t) YY_NOEXCEPT;
+
+    /// Convert the symbol name \a n to a form suitable for a diagnostic.
+    static std::string yytnamerr_ (const char *yystr);
+
+    /// For a symbol, its name in clear.
+    static const char* const yytname_[];
+
 
     // Tables.
     // YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
@@ -999,37 +1196,31 @@ switch (yytype)
 
     static const signed char yycheck_[];
 
-    // YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-    // symbol of state STATE-NUM.
+    // YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+    // state STATE-NUM.
     static const signed char yystos_[];
 
-    // YYR1[YYN] -- Symbol number of symbol that rule YYN derives.
+    // YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.
     static const signed char yyr1_[];
 
-    // YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.
+    // YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.
     static const signed char yyr2_[];
 
 
-    /// Convert the symbol name \a n to a form suitable for a diagnostic.
-    static std::string yytnamerr_ (const char *n);
-
-
-    /// For a symbol, its name in clear.
-    static const char* const yytname_[];
 #if YYDEBUG
     // YYRLINE[YYN] -- Source line where rule number YYN was defined.
-    static const signed char yyrline_[];
+    static const unsigned char yyrline_[];
     /// Report on the debug stream that the rule \a r is going to be reduced.
-    virtual void yy_reduce_print_ (int r);
+    virtual void yy_reduce_print_ (int r) const;
     /// Print the state stack on the debug stream.
-    virtual void yystack_print_ ();
+    virtual void yy_stack_print_ () const;
 
     /// Debugging level.
     int yydebug_;
     /// Debug stream.
     std::ostream* yycdebug_;
 
-    /// \brief Display a symbol type, value and location.
+    /// \brief Display a symbol kind, value and location.
     /// \param yyo    The output stream.
     /// \param yysym  The symbol.
     template <typename Base>
@@ -1050,7 +1241,7 @@ switch (yytype)
       /// Default constructor.
       by_state () YY_NOEXCEPT;
 
-      /// The symbol type as needed by the constructor.
+      /// The symbol kind as needed by the constructor.
       typedef state_type kind_type;
 
       /// Constructor.
@@ -1062,12 +1253,12 @@ switch (yytype)
       /// Record that this symbol is empty.
       void clear () YY_NOEXCEPT;
 
-      /// Steal the symbol type from \a that.
+      /// Steal the symbol kind from \a that.
       void move (by_state& that);
 
-      /// The (internal) type number (corresponding to \a state).
-      /// \a empty_symbol when empty.
-      symbol_number_type type_get () const YY_NOEXCEPT;
+      /// The symbol kind (corresponding to \a state).
+      /// \a symbol_kind::S_YYEMPTY when empty.
+      symbol_kind_type kind () const YY_NOEXCEPT;
 
       /// The state number used to denote an empty symbol.
       /// We use the initial state, as it does not have a value.
@@ -1106,15 +1297,22 @@ switch (yytype)
     {
     public:
       // Hide our reversed order.
-      typedef typename S::reverse_iterator iterator;
-      typedef typename S::const_reverse_iterator const_iterator;
+      typedef typename S::iterator iterator;
+      typedef typename S::const_iterator const_iterator;
       typedef typename S::size_type size_type;
       typedef typename std::ptrdiff_t index_type;
 
-      stack (size_type n = 200)
+      stack (size_type n = 200) YY_NOEXCEPT
         : seq_ (n)
       {}
 
+#if 201103L <= YY_CPLUSPLUS
+      /// Non copyable.
+      stack (const stack&) = delete;
+      /// Non copyable.
+      stack& operator= (const stack&) = delete;
+#endif
+
       /// Random access.
       ///
       /// Index 0 returns the topmost element.
@@ -1165,31 +1363,25 @@ switch (yytype)
         return index_type (seq_.size ());
       }
 
-      std::ptrdiff_t
-      ssize () const YY_NOEXCEPT
-      {
-        return std::ptrdiff_t (size ());
-      }
-
       /// Iterator on top of the stack (going downwards).
       const_iterator
       begin () const YY_NOEXCEPT
       {
-        return seq_.rbegin ();
+        return seq_.begin ();
       }
 
       /// Bottom of the stack.
       const_iterator
       end () const YY_NOEXCEPT
       {
-        return seq_.rend ();
+        return seq_.end ();
       }
 
       /// Present a slice of the top of a stack.
       class slice
       {
       public:
-        slice (const stack& stack, index_type range)
+        slice (const stack& stack, index_type range) YY_NOEXCEPT
           : stack_ (stack)
           , range_ (range)
         {}
@@ -1206,8 +1398,12 @@ switch (yytype)
       };
 
     private:
+#if YY_CPLUSPLUS < 201103L
+      /// Non copyable.
       stack (const stack&);
+      /// Non copyable.
       stack& operator= (const stack&);
+#endif
       /// The wrapped container.
       S seq_;
     };
@@ -1244,33 +1440,31 @@ switch (yytype)
     void yypush_ (const char* m, state_type s, YY_MOVE_REF (symbol_type) sym);
 
     /// Pop \a n symbols from the stack.
-    void yypop_ (int n = 1);
-
-    /// Some specific tokens.
-    static const token_number_type yy_error_token_ = 1;
-    static const token_number_type yy_undef_token_ = 2;
+    void yypop_ (int n = 1) YY_NOEXCEPT;
 
     /// Constants.
     enum
     {
-      yyeof_ = 0,
-      yylast_ = 31,     ///< Last index in yytable_.
-      yynnts_ = 5,  ///< Number of nonterminal symbols.
-      yyfinal_ = 4, ///< Termination state number.
-      yyntokens_ = 14  ///< Number of tokens.
+      yylast_ = 38,     ///< Last index in yytable_.
+      yynnts_ = 9,  ///< Number of nonterminal symbols.
+      yyfinal_ = 6 ///< Termination state number.
     };
 
 
+    // User arguments.
+    euler::Scanner& scanner;
+    euler::ParseContext& parse_context;
+
   };
 
   inline
-  parser::token_number_type
-  parser::yytranslate_ (int t)
+  parser::symbol_kind_type
+  parser::yytranslate_ (int t) YY_NOEXCEPT
   {
     // YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to
     // TOKEN-NUM as returned by yylex.
     static
-    const token_number_type
+    const signed char
     translate_table[] =
     {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -1301,76 +1495,42 @@ switch (yytype)
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12
     };
-    const int user_token_number_max_ = 267;
+    // Last valid token kind.
+    const int code_max = 267;
 
     if (t <= 0)
-      return yyeof_;
-    else if (t <= user_token_number_max_)
-      return translate_table[t];
+      return symbol_kind::S_YYEOF;
+    else if (t <= code_max)
+      return static_cast <symbol_kind_type> (translate_table[t]);
     else
-      return yy_undef_token_;
+      return symbol_kind::S_YYUNDEF;
   }
 
   // basic_symbol.
-#if 201103L <= YY_CPLUSPLUS
-  template <typename Base>
-  parser::basic_symbol<Base>::basic_symbol (basic_symbol&& that)
-    : Base (std::move (that))
-    , value ()
-  {
-    switch (this->type_get ())
-    {
-      case 11: // NUMBER
-        value.move< double > (std::move (that.value));
-        break;
-
-      case 5: // MOS_TYPE
-        value.move< euler::Mos::Type > (std::move (that.value));
-        break;
-
-      case 16: // mos
-        value.move< std::shared_ptr<euler::Mos> > (std::move (that.value));
-        break;
-
-      case 10: // NAME
-        value.move< std::string > (std::move (that.value));
-        break;
-
-      case 17: // mos_list
-        value.move< std::vector<std::shared_ptr<euler::Mos>> > (std::move (that.value));
-        break;
-
-      default:
-        break;
-    }
-
-  }
-#endif
-
   template <typename Base>
   parser::basic_symbol<Base>::basic_symbol (const basic_symbol& that)
     : Base (that)
     , value ()
   {
-    switch (this->type_get ())
+    switch (this->kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.copy< double > (YY_MOVE (that.value));
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.copy< euler::Mos::Type > (YY_MOVE (that.value));
         break;
 
-      case 16: // mos
-        value.copy< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
+      case symbol_kind::S_NAME: // NAME
+        value.copy< euler::Symbol > (YY_MOVE (that.value));
         break;
 
-      case 10: // NAME
-        value.copy< std::string > (YY_MOVE (that.value));
+      case symbol_kind::S_mos: // mos
+        value.copy< std::shared_ptr<euler::Mos> > (YY_MOVE (that.value));
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.copy< std::vector<std::shared_ptr<euler::Mos>> > (YY_MOVE (that.value));
         break;
 
@@ -1382,11 +1542,20 @@ switch (yytype)
 
 
 
+
+  template <typename Base>
+  parser::symbol_kind_type
+  parser::basic_symbol<Base>::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
+
+
   template <typename Base>
   bool
   parser::basic_symbol<Base>::empty () const YY_NOEXCEPT
   {
-    return Base::type_get () == empty_symbol;
+    return this->kind () == symbol_kind::S_YYEMPTY;
   }
 
   template <typename Base>
@@ -1394,25 +1563,25 @@ switch (yytype)
   parser::basic_symbol<Base>::move (basic_symbol& s)
   {
     super_type::move (s);
-    switch (this->type_get ())
+    switch (this->kind ())
     {
-      case 11: // NUMBER
+      case symbol_kind::S_NUMBER: // NUMBER
         value.move< double > (YY_MOVE (s.value));
         break;
 
-      case 5: // MOS_TYPE
+      case symbol_kind::S_MOS_TYPE: // MOS_TYPE
         value.move< euler::Mos::Type > (YY_MOVE (s.value));
         break;
 
-      case 16: // mos
-        value.move< std::shared_ptr<euler::Mos> > (YY_MOVE (s.value));
+      case symbol_kind::S_NAME: // NAME
+        value.move< euler::Symbol > (YY_MOVE (s.value));
         break;
 
-      case 10: // NAME
-        value.move< std::string > (YY_MOVE (s.value));
+      case symbol_kind::S_mos: // mos
+        value.move< std::shared_ptr<euler::Mos> > (YY_MOVE (s.value));
         break;
 
-      case 17: // mos_list
+      case symbol_kind::S_mos_list: // mos_list
         value.move< std::vector<std::shared_ptr<euler::Mos>> > (YY_MOVE (s.value));
         break;
 
@@ -1422,56 +1591,66 @@ switch (yytype)
 
   }
 
-  // by_type.
+  // by_kind.
   inline
-  parser::by_type::by_type ()
-    : type (empty_symbol)
+  parser::by_kind::by_kind () YY_NOEXCEPT
+    : kind_ (symbol_kind::S_YYEMPTY)
   {}
 
 #if 201103L <= YY_CPLUSPLUS
   inline
-  parser::by_type::by_type (by_type&& that)
-    : type (that.type)
+  parser::by_kind::by_kind (by_kind&& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
   {
     that.clear ();
   }
 #endif
 
   inline
-  parser::by_type::by_type (const by_type& that)
-    : type (that.type)
+  parser::by_kind::by_kind (const by_kind& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
   {}
 
   inline
-  parser::by_type::by_type (token_type t)
-    : type (yytranslate_ (t))
+  parser::by_kind::by_kind (token_kind_type t) YY_NOEXCEPT
+    : kind_ (yytranslate_ (t))
   {}
 
+
+
   inline
   void
-  parser::by_type::clear ()
+  parser::by_kind::clear () YY_NOEXCEPT
   {
-    type = empty_symbol;
+    kind_ = symbol_kind::S_YYEMPTY;
   }
 
   inline
   void
-  parser::by_type::move (by_type& that)
+  parser::by_kind::move (by_kind& that)
   {
-    type = that.type;
+    kind_ = that.kind_;
     that.clear ();
   }
 
   inline
-  int
-  parser::by_type::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_kind::kind () const YY_NOEXCEPT
   {
-    return type;
+    return kind_;
   }
 
-} // yy
-#line 1474 "y.tab.hh"
 
+  inline
+  parser::symbol_kind_type
+  parser::by_kind::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
+
+
+} // yy
+#line 1654 "y.tab.hh"
 
 
 
@@ -0,0 +1,385 @@
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "instance.h"
+#include "parse.h"
+#include "result.h"
+#include "router.h"
+
+using namespace routing;
+
+namespace routing {
+
+/// @brief Runs the phases of the router one by one, timing each of them.
+class RouterBenchmark {
+ public:
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  struct Result {
+    Milliseconds construct_horizontal_constraint_graph{};
+    Milliseconds construct_vertical_constraint_graph{};
+    Milliseconds compute_lower_bounds{};
+    Milliseconds route_in_boundaries{};
+    Milliseconds route_in_tracks{};
+    std::size_t number_of_nets = 0;
+    std::size_t number_of_vertical_constraints = 0;
+    std::size_t number_of_tracks = 0;
+    LowerBounds lower_bounds{};
+  };
+
+  /// @return Nothing if the vertical constraints are cyclic.
+  static std::optional<Result> Run(const Instance& instance,
+                                   RouterOption option) {
+    auto result = Result{};
+    auto router = Router{instance, option};
+    result.number_of_nets = router.number_of_nets_;
+    result.construct_horizontal_constraint_graph
+        = Time_([&]() { router.ConstructHorizontalConstraintGraph_(); });
+    // The check of the cycles and the reduction are part of the VCG, as they
+    // are done on it before routing.
+    auto is_cyclic = false;
+    result.construct_vertical_constraint_graph = Time_([&]() {
+      router.ConstructVerticalConstraintGraph_();
+      is_cyclic = !router.vertical_constraint_graph_.FindCycle().empty();
+      if (!is_cyclic && option.transitive_reduction) {
+        router.vertical_constraint_graph_.ReduceTransitively();
+        router.inverted_vertical_constraint_graph_
+            = router.vertical_constraint_graph_.Inverted();
+      }
+    });
+    if (is_cyclic) {
+      return std::nullopt;
+    }
+    result.number_of_vertical_constraints
+        = router.vertical_constraint_graph_.NumberOfEdges();
+
+    result.compute_lower_bounds = Time_(
+        [&]() { result.lower_bounds = router.ComputeLowerBounds_(); });
+    result.route_in_boundaries = Time_([&]() {
+      router.route_place_of_nets_.assign(router.number_of_nets_ + 1,
+                                         RoutePlace{});
+      router.RouteInBoundaries_(BoundaryKind::kTop);
+      router.RouteInBoundaries_(BoundaryKind::kBottom);
+    });
+    result.route_in_tracks = Time_(
+        [&]() { result.number_of_tracks = router.RouteInTracks_(); });
+    return result;
+  }
+
+ private:
+  template <typename F>
+  static Milliseconds Time_(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::steady_clock::now() - start;
+  }
+};
+
+}  // namespace routing
+
+namespace {
+
+void Usage(const char* prog_name) {
+  // clang-format off
+  std::cerr << "Usage: " << prog_name << " [-h] [-r] [-n N] [-e N [-s SEED]] IN\n";
+  std::cerr << '\n';
+  std::cerr << "    Times the phases of the router on IN and reports them as JSON.\n";
+  std::cerr << '\n';
+  std::cerr << "Options:\n";
+  std::cerr << "    -r        Drops the vertical constraints implied by others before\n";
+  std::cerr << "              routing\n";
+  std::cerr << "    -n N      Repeats N times and reports the fastest of each phase\n";
+  std::cerr << "              (default: 1)\n";
+  std::cerr << "    -e N      Also swaps the top pins of two nearby random columns N times,\n";
+  std::cerr << "              rerouting after each swap, and checks the rerouted result\n";
+  std::cerr << "    -s SEED   The random seed of the swaps (default: 0)\n";
+  std::cerr << "    -h        Prints this help message\n";
+  // clang-format on
+}
+
+std::string Quote(const std::string& s) {
+  auto quoted = std::string{'"'};
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      quoted.push_back('\\');
+    }
+    quoted.push_back(c);
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+struct EcoResult {
+  int number_of_rounds = 0;
+  /// @brief The swaps undone, as they make the vertical constraints cyclic.
+  int number_of_cyclic_rounds = 0;
+  RouterBenchmark::Milliseconds reroute{};
+  /// @brief The places that break the constraints, summed over the rounds.
+  std::size_t number_of_invalid_places = 0;
+  std::size_t number_of_tracks = 0;
+  /// @brief Of the channel routed again from scratch after the last round.
+  RouterBenchmark::Milliseconds route{};
+  std::size_t number_of_tracks_from_scratch = 0;
+};
+
+/// @return The number of the nets that are placed over a different interval
+/// from their pins, overlap another net on the same track, or aren't above
+/// the net under them at a column.
+/// @note The nets in the boundaries are not checked against the boundaries
+/// themselves.
+std::size_t CountInvalidPlaces(const Instance& instance, const Result& result) {
+  const auto& places = result.route_place_of_nets;
+  auto intervals = std::vector<std::optional<Interval>>(places.size());
+  for (auto column = std::size_t{0}; column < instance.top_net_ids.size();
+       column++) {
+    for (auto net_id : {instance.top_net_ids.at(column),
+                        instance.bottom_net_ids.at(column)}) {
+      if (net_id == kEmptySlot) {
+        continue;
+      }
+      auto& interval = intervals.at(net_id);
+      interval = interval ? Interval{interval->first, column}
+                          : Interval{column, column};
+    }
+  }
+
+  auto number_of_invalid_places = std::size_t{0};
+  auto tracks = std::map<std::pair<RoutePlaceKind, unsigned>,
+                         std::vector<Interval>>{};
+  for (auto net_id = std::size_t{1}; net_id < places.size(); net_id++) {
+    const auto& place = places.at(net_id);
+    if (!intervals.at(net_id) || place.interval != *intervals.at(net_id)) {
+      number_of_invalid_places++;
+    }
+    tracks[{place.kind, place.track}].push_back(place.interval);
+  }
+  for (auto& [_, intervals_on_track] : tracks) {
+    std::sort(intervals_on_track.begin(), intervals_on_track.end());
+    for (auto i = std::size_t{1}; i < intervals_on_track.size(); i++) {
+      if (intervals_on_track.at(i).first
+          <= intervals_on_track.at(i - 1).second) {
+        number_of_invalid_places++;
+      }
+    }
+  }
+
+  // The top boundary is above all the tracks, and the bottom one below.
+  const auto HeightOf = [](const RoutePlace& place) {
+    constexpr auto kTopBase = 1LL << 40;
+    switch (place.kind) {
+      case RoutePlaceKind::kTop:
+        return kTopBase + place.track;
+      case RoutePlaceKind::kTrack:
+        return static_cast<long long>(place.track);
+      case RoutePlaceKind::kBottom:
+        return -static_cast<long long>(place.track);
+    }
+    return 0LL;
+  };
+  for (auto column = std::size_t{0}; column < instance.top_net_ids.size();
+       column++) {
+    const auto top_net_id = instance.top_net_ids.at(column);
+    const auto bottom_net_id = instance.bottom_net_ids.at(column);
+    if (top_net_id != kEmptySlot && bottom_net_id != kEmptySlot
+        && top_net_id != bottom_net_id
+        && HeightOf(places.at(top_net_id))
+               <= HeightOf(places.at(bottom_net_id))) {
+      number_of_invalid_places++;
+    }
+  }
+  return number_of_invalid_places;
+}
+
+/// @brief Routes the instance, then swaps the top pins of two random columns
+/// at most `kEcoWindow` apart and reroutes in each round. The swaps keep the
+/// number of the pins of every net, but may make the vertical constraints
+/// cyclic.
+constexpr auto kEcoWindow = std::size_t{16};
+
+EcoResult RunEco(Instance instance, RouterOption option, int number_of_rounds,
+                 unsigned seed) {
+  auto eco = EcoResult{};
+  auto router = Router{instance, option};
+  auto result = router.Route();
+  if (!result || instance.top_net_ids.size() < 2) {
+    return eco;
+  }
+  auto random = std::mt19937{seed};
+  const auto number_of_columns = instance.top_net_ids.size();
+  auto Column = std::uniform_int_distribution<std::size_t>{
+      0, number_of_columns - 1};
+  auto Offset = std::uniform_int_distribution<std::size_t>{1, kEcoWindow};
+  for (auto round = 0; round < number_of_rounds; round++) {
+    const auto a = Column(random);
+    const auto b = (a + Offset(random)) % number_of_columns;
+    const auto changes = std::vector<PinChange>{
+        {a, instance.top_net_ids.at(b), instance.bottom_net_ids.at(a)},
+        {b, instance.top_net_ids.at(a), instance.bottom_net_ids.at(b)},
+    };
+    const auto start = std::chrono::steady_clock::now();
+    const auto is_rerouted = router.Reroute(changes, *result);
+    eco.reroute += std::chrono::steady_clock::now() - start;
+    eco.number_of_rounds++;
+    if (!is_rerouted) {
+      eco.number_of_cyclic_rounds++;
+    } else {
+      std::swap(instance.top_net_ids.at(a), instance.top_net_ids.at(b));
+    }
+    eco.number_of_invalid_places += CountInvalidPlaces(instance, *result);
+  }
+  eco.number_of_tracks = result->number_of_tracks;
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto from_scratch = Router{instance, option}.Route();
+  eco.route = std::chrono::steady_clock::now() - start;
+  eco.number_of_tracks_from_scratch = from_scratch->number_of_tracks;
+  return eco;
+}
+
+/// @return In kibibytes.
+long PeakRss() {
+  auto usage = rusage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto number_of_repeats = 1;
+  auto number_of_eco_rounds = 0;
+  auto seed = 0U;
+  auto option = RouterOption{};
+  int c;
+  while ((c = getopt(argc, argv, "rn:e:s:h")) != -1) {
+    switch (c) {
+      case 'r':
+        option.transitive_reduction = true;
+        break;
+      case 'n':
+        number_of_repeats = std::max(1, std::atoi(optarg));
+        break;
+      case 'e':
+        number_of_eco_rounds = std::max(0, std::atoi(optarg));
+        break;
+      case 's':
+        seed = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+        break;
+      case 'h':
+        Usage(argv[0]);
+        return EXIT_SUCCESS;
+      default:
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (optind + 1 != argc) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  const auto in_file = std::string{argv[optind]};
+
+  auto parse = RouterBenchmark::Milliseconds::max();
+  auto instance = Instance{};
+  for (auto i = 0; i < number_of_repeats; i++) {
+    auto in = std::ifstream{in_file};
+    if (!in) {
+      std::perror(in_file.c_str());
+      return EXIT_FAILURE;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto parsed = Parse(in);
+    parse = std::min<RouterBenchmark::Milliseconds>(
+        parse, std::chrono::steady_clock::now() - start);
+    if (!parsed) {
+      return EXIT_FAILURE;
+    }
+    instance = std::move(*parsed);
+  }
+
+  auto best = RouterBenchmark::Run(instance, option);
+  if (!best) {
+    std::cerr << in_file << ": The vertical constraints are cyclic\n";
+    return EXIT_FAILURE;
+  }
+  for (auto i = 1; i < number_of_repeats; i++) {
+    const auto result = *RouterBenchmark::Run(instance, option);
+    best->construct_horizontal_constraint_graph
+        = std::min(best->construct_horizontal_constraint_graph,
+                   result.construct_horizontal_constraint_graph);
+    best->construct_vertical_constraint_graph
+        = std::min(best->construct_vertical_constraint_graph,
+                   result.construct_vertical_constraint_graph);
+    best->compute_lower_bounds
+        = std::min(best->compute_lower_bounds, result.compute_lower_bounds);
+    best->route_in_boundaries
+        = std::min(best->route_in_boundaries, result.route_in_boundaries);
+    best->route_in_tracks
+        = std::min(best->route_in_tracks, result.route_in_tracks);
+  }
+
+  auto eco = std::optional<EcoResult>{};
+  if (number_of_eco_rounds) {
+    eco = RunEco(instance, option, number_of_eco_rounds, seed);
+  }
+
+  std::cout << "{\n";
+  std::cout << "  \"instance\": " << Quote(in_file) << ",\n";
+  std::cout << "  \"pins\": " << instance.top_net_ids.size() << ",\n";
+  std::cout << "  \"nets\": " << best->number_of_nets << ",\n";
+  std::cout << "  \"vertical_constraints\": "
+            << best->number_of_vertical_constraints << ",\n";
+  std::cout << "  \"parse_ms\": " << parse.count() << ",\n";
+  std::cout << "  \"construct_hcg_ms\": "
+            << best->construct_horizontal_constraint_graph.count() << ",\n";
+  std::cout << "  \"construct_vcg_ms\": "
+            << best->construct_vertical_constraint_graph.count() << ",\n";
+  std::cout << "  \"compute_lower_bounds_ms\": "
+            << best->compute_lower_bounds.count() << ",\n";
+  std::cout << "  \"route_in_boundaries_ms\": "
+            << best->route_in_boundaries.count() << ",\n";
+  std::cout << "  \"route_in_tracks_ms\": " << best->route_in_tracks.count()
+            << ",\n";
+  std::cout << "  \"tracks\": " << best->number_of_tracks << ",\n";
+  std::cout << "  \"density_lower_bound\": "
+            << best->lower_bounds.density << ",\n";
+  std::cout << "  \"vertical_constraint_lower_bound\": "
+            << best->lower_bounds.vertical_constraint << ",\n";
+  std::cout << "  \"meets_lower_bound\": "
+            << (best->lower_bounds.IsMetBy(best->number_of_tracks) ? "true"
+                                                                   : "false")
+            << ",\n";
+  if (eco) {
+    std::cout << "  \"eco_rounds\": " << eco->number_of_rounds << ",\n";
+    std::cout << "  \"eco_cyclic_rounds\": " << eco->number_of_cyclic_rounds
+              << ",\n";
+    std::cout << "  \"reroute_ms\": " << eco->reroute.count() << ",\n";
+    std::cout << "  \"eco_invalid_places\": " << eco->number_of_invalid_places
+              << ",\n";
+    std::cout << "  \"eco_tracks\": " << eco->number_of_tracks << ",\n";
+    std::cout << "  \"eco_route_ms\": " << eco->route.count() << ",\n";
+    std::cout << "  \"eco_route_tracks\": "
+              << eco->number_of_tracks_from_scratch << ",\n";
+  }
+  std::cout << "  \"peak_rss_kib\": " << PeakRss() << "\n";
+  std::cout << "}" << std::endl;
+  if (eco && eco->number_of_invalid_places) {
+    std::cerr << in_file << ": The rerouted result is invalid\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
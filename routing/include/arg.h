@@ -14,33 +14,85 @@ constexpr int kNumberOfArguments = 2;
 struct Argument {
   std::string in;
   std::string out;
+  /// @brief Drops the vertical constraints implied by others before routing.
+  bool transitive_reduction = false;
+  /// @brief Takes `in` as a manifest of instances and `out` as the directory
+  /// to write their results to.
+  bool batch = false;
+  /// @brief The number of instances routed at once in the batch mode. 0
+  /// means to use all the hardware threads.
+  unsigned threads = 0;
+  /// @brief Appends the lower bounds of the extra tracks to the first line of
+  /// the result.
+  bool lower_bounds = false;
 };
 
 inline void Usage(const char* prog_name) {
   // clang-format off
-  std::cerr << "Usage: " << prog_name << " IN OUT\n";
+  std::cerr << "Usage: " << prog_name << " [-h] [-r] [-l] [-b] [-j N] IN OUT\n";
   std::cerr << '\n';
   std::cerr << "Options:\n";
+  std::cerr << "    -r, --transitive-reduction\n";
+  std::cerr << "                     Drops the vertical constraints implied by others before\n";
+  std::cerr << "                     routing, which speeds up channels of deep constraints\n";
+  std::cerr << "    -l, --lower-bounds\n";
+  std::cerr << "                     Appends the lower bounds of the extra tracks, from the\n";
+  std::cerr << "                     density and the vertical constraints, to the first line\n";
+  std::cerr << "                     of OUT\n";
+  std::cerr << "    -b, --batch      Routes each instance listed in IN, one path per line\n";
+  std::cerr << "                     relative to IN, to OUT/NAME.out, on multiple threads\n";
+  std::cerr << "    -j, --threads N  Routes N instances at once with -b\n";
+  std::cerr << "                     (default: the number of hardware threads)\n";
   std::cerr << "    -h, --help       Prints this help message\n";
   std::cerr << '\n';
   std::cerr << "Arguments:\n";
-  std::cerr << "    IN               The file to read the channel routing instance from\n";
-  std::cerr << "    OUT              The file to write the channel routing result to\n";
+  std::cerr << "    IN               The file (or manifest with -b) to read the channel routing\n";
+  std::cerr << "                     instance from\n";
+  std::cerr << "    OUT              The file (or directory with -b) to write the channel routing\n";
+  std::cerr << "                     result to\n";
   // clang-format on
 }
 
 inline struct option long_options[] = {
+    {"transitive-reduction", no_argument, 0, 'r'},
+    {"lower-bounds", no_argument, 0, 'l'},
+    {"batch", no_argument, 0, 'b'},
+    {"threads", required_argument, 0, 'j'},
     {"help", no_argument, 0, 'h'},
     {0, 0, 0, 0},
 };
 
+/// @note Exits with failure if `value` is not a non-negative integer.
+inline unsigned ParseUnsigned(const char* prog_name, const char* value) {
+  char* end = nullptr;
+  auto number = std::strtoul(value, &end, 10);
+  if (*value == '\0' || *value == '-' || *end != '\0') {
+    std::cerr << prog_name << ": invalid number -- " << value << '\n';
+    Usage(prog_name);
+    std::exit(EXIT_FAILURE);
+  }
+  return static_cast<unsigned>(number);
+}
+
 inline Argument HandleArguments(int argc, char** argv) {
   auto arg = Argument{};
 
   // Handle options
   int c;
-  while ((c = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+  while ((c = getopt_long(argc, argv, "rlbj:h", long_options, nullptr)) != -1) {
     switch (c) {
+      case 'r':
+        arg.transitive_reduction = true;
+        break;
+      case 'l':
+        arg.lower_bounds = true;
+        break;
+      case 'b':
+        arg.batch = true;
+        break;
+      case 'j':
+        arg.threads = ParseUnsigned(argv[0], optarg);
+        break;
       case 'h':
         Usage(argv[0]);
         std::exit(EXIT_SUCCESS);
@@ -0,0 +1,72 @@
+#ifndef ROUTING_CONSTRAINT_GRAPH_H_
+#define ROUTING_CONSTRAINT_GRAPH_H_
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "instance.h"
+
+namespace routing {
+
+/// @brief A directed graph on the nets, stored in the compressed sparse row
+/// form: the neighbors of all the nets are kept in a single array, in the
+/// order of the nets.
+/// @note Net 0 is not used, as in the instance.
+class ConstraintGraph {
+ public:
+  std::span<const NetId> NeighborsOf(NetId net_id) const {
+    return {neighbors_.data() + offsets_.at(net_id),
+            neighbors_.data() + offsets_.at(net_id + 1)};
+  }
+
+  /// @return The number of the neighbors of the net.
+  std::size_t DegreeOf(NetId net_id) const {
+    return offsets_.at(net_id + 1) - offsets_.at(net_id);
+  }
+
+  /// @return The number of the edges, with the duplicates dropped.
+  std::size_t NumberOfEdges() const {
+    return neighbors_.size();
+  }
+
+  /// @return The graph with all the edges reversed.
+  ConstraintGraph Inverted() const;
+
+  /// @return The nets in a topological order, i.e., each net precedes its
+  /// neighbors; those on or after a cycle are left out.
+  std::vector<NetId> TopologicalOrder() const;
+
+  /// @return The nets of a cycle, each of which has the next one as a
+  /// neighbor, and the last has the first; empty if the graph is acyclic.
+  /// @note Linear in the size of the graph.
+  std::vector<NetId> FindCycle() const;
+
+  /// @brief Drops the edges to the neighbors that are also reachable through
+  /// other neighbors, which leaves the reachability unchanged.
+  /// @note The graph must be acyclic. Each net searches the nets reachable
+  /// from it, so this takes up to O(nets x edges) on deep graphs.
+  void ReduceTransitively();
+
+  ConstraintGraph() = default;
+  /// @param edges The pairs of the net and its neighbor, in any order and
+  /// with duplicates, which are dropped in linear time.
+  ConstraintGraph(unsigned number_of_nets,
+                  const std::vector<std::pair<NetId, NetId>>& edges);
+
+ private:
+  /// @brief The neighbors of net n are those in [offsets_[n],
+  /// offsets_[n + 1]) of `neighbors_`.
+  std::vector<std::size_t> offsets_{0, 0};
+  std::vector<NetId> neighbors_{};
+
+  unsigned NumberOfNets_() const {
+    return static_cast<unsigned>(offsets_.size() - 2);
+  }
+
+};
+
+}  // namespace routing
+
+#endif  // ROUTING_CONSTRAINT_GRAPH_H_
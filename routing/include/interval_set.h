@@ -0,0 +1,36 @@
+#ifndef ROUTING_INTERVAL_SET_H_
+#define ROUTING_INTERVAL_SET_H_
+
+#include <vector>
+
+#include "instance.h"
+
+namespace routing {
+
+/// @brief A set of the positions covered by intervals, kept as the sorted
+/// intervals that neither overlap nor touch each other, i.e., the intervals
+/// that overlap or are adjacent are coalesced into one.
+class IntervalSet {
+ public:
+  /// @brief Adds the intervals to the set in a single merge pass.
+  /// @param intervals Sorted by the start of the interval.
+  /// @note Linear in the size of the set and the intervals.
+  void Merge(const std::vector<Interval>& intervals);
+
+  /// @return Whether `interval` is contained by one of the intervals of the
+  /// set (proper subset), as in `IsContainedBy`.
+  /// @note Logarithmic in the size of the set.
+  bool Contains(const Interval& interval) const;
+
+  /// @note Are sorted by the start of the interval.
+  const std::vector<Interval>& Intervals() const {
+    return intervals_;
+  }
+
+ private:
+  std::vector<Interval> intervals_{};
+};
+
+}  // namespace routing
+
+#endif  // ROUTING_INTERVAL_SET_H_
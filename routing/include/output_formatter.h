@@ -7,16 +7,22 @@
 
 namespace routing {
 
+/// @brief Writes the result in the order of the nets, through a buffer that
+/// is flushed to the stream in large blocks.
 class OutputFormatter {
  public:
+  /// @note No end-of-file newline.
   void Out();
 
-  OutputFormatter(std::ostream& out, Result result)
-      : out_{out}, result_{result} {}
+  /// @param with_lower_bounds Appends the lower bounds to the first line.
+  OutputFormatter(std::ostream& out, const Result& result,
+                  bool with_lower_bounds = false)
+      : out_{out}, result_{result}, with_lower_bounds_{with_lower_bounds} {}
 
  private:
   std::ostream& out_;
-  Result result_;
+  const Result& result_;
+  bool with_lower_bounds_;
 };
 
 }  // namespace routing
@@ -0,0 +1,19 @@
+#ifndef ROUTING_PARSE_H_
+#define ROUTING_PARSE_H_
+
+#include <iosfwd>
+#include <optional>
+
+#include "instance.h"
+
+namespace routing {
+
+/// @brief Parses the channel routing instance.
+/// @note Reentrant; the instances can be parsed on multiple threads at once.
+/// @return The instance, or nothing on a syntax error, which is reported to
+/// the standard error.
+std::optional<Instance> Parse(std::istream& in);
+
+}  // namespace routing
+
+#endif  // ROUTING_PARSE_H_
@@ -1,22 +1,60 @@
 #ifndef ROUTING_RESULT_H_
 #define ROUTING_RESULT_H_
 
-#include <tuple>
+#include <cstddef>
 #include <vector>
 
 #include "instance.h"
 
 namespace routing {
 
-struct Result {
+enum class RoutePlaceKind {
   /// @brief The space between the top rectilinear boundary and the topmost
   /// track.
-  std::vector<std::vector<std::tuple<Interval, NetId>>> top_tracks;
+  kTop,
   /// @brief The extra tracks in the channel.
-  std::vector<std::vector<std::tuple<Interval, NetId>>> tracks;
+  kTrack,
   /// @brief The space between the bottom rectilinear boundary and the
   /// bottommost track.
-  std::vector<std::vector<std::tuple<Interval, NetId>>> bottom_tracks;
+  kBottom,
+};
+
+struct RoutePlace {
+  RoutePlaceKind kind;
+  /// @brief In the top and bottom, the distance from the innermost boundary,
+  /// starting from 0; in the channel, counted from the bottommost track,
+  /// which is 1.
+  unsigned track;
+  Interval interval;
+};
+
+/// @brief The lower bounds of the number of the extra tracks, with the
+/// tracks in the boundaries taken into account.
+struct LowerBounds {
+  /// @brief From the nets that cross a column, less those that the boundary
+  /// tracks over and under it can take.
+  std::size_t density;
+  /// @brief From the longest chain of the vertical constraints, whose nets
+  /// all take different tracks.
+  std::size_t vertical_constraint;
+
+  /// @return Whether the number of the extra tracks meets one of the bounds,
+  /// in which case no routing uses fewer of them and there's nothing left to
+  /// improve.
+  bool IsMetBy(std::size_t number_of_tracks) const {
+    return number_of_tracks <= density
+           || number_of_tracks <= vertical_constraint;
+  }
+};
+
+struct Result {
+  /// @brief The number of the extra tracks in the channel.
+  std::size_t number_of_tracks;
+  /// @note Of the channel given to `Route`; `Reroute` doesn't update them.
+  LowerBounds lower_bounds;
+  /// @brief Where each net is routed, indexed by the net id.
+  /// @note Index 0 is not used.
+  std::vector<RoutePlace> route_place_of_nets;
 };
 
 }  // namespace routing
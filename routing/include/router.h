@@ -1,35 +1,96 @@
 #ifndef ROUTING_ROUTER_H_
 #define ROUTING_ROUTER_H_
 
+#include <cstddef>
+#include <map>
+#include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "constraint_graph.h"
 #include "instance.h"
 #include "result.h"
 
 namespace routing {
 
+struct RouterOption {
+  /// @brief Drops the vertical constraints implied by others before routing,
+  /// which makes the checks of the parents cheaper on deep graphs.
+  bool transitive_reduction = false;
+};
+
+/// @brief The new nets of the pins in a column.
+struct PinChange {
+  std::size_t column;
+  NetId top_net_id;
+  NetId bottom_net_id;
+};
+
 class Router {
  public:
   /// @note This function is safe to call multiple times. Although the result
-  /// will be the same.
-  Result Route();
+  /// will be the same, unless the pins are changed by `Reroute` in between.
+  /// @return Nothing if the vertical constraints are cyclic, which the
+  /// Constraint Left-Edge algorithm can't route without doglegs. The cycle
+  /// is then given by `CyclicNets`.
+  std::optional<Result> Route();
+
+  /// @brief Changes the pins and updates `result`, which is the result of the
+  /// last `Route` or `Reroute`, in place. Only the nets on the changed
+  /// columns are ripped up. They are packed, parents first, into the highest
+  /// free place in the existing tracks between their parents and their
+  /// children, or into a new topmost track. If some of them don't fit,
+  /// everything is routed again with `Route`. The tracks left empty are
+  /// removed, with the tracks above them moved down.
+  /// @note The changes shall keep the net ids consecutive, i.e., neither add
+  /// new nets nor remove all the pins of a net.
+  /// @note Takes time in the number of the changed nets and the columns they
+  /// span, not in the size of the channel, unless it falls back to `Route`
+  /// or a track is left empty, which renumbers the nets above it.
+  /// @return False if the vertical constraints become cyclic, which is then
+  /// given by `CyclicNets`. The changes are then undone, and `result` is left
+  /// unchanged.
+  bool Reroute(const std::vector<PinChange>& changes, Result& result);
 
-  explicit Router(Instance);
+  /// @return The nets of the cycle found by the last `Route`, each of which
+  /// is to be routed below the next one, and the last below the first.
+  const std::vector<NetId>& CyclicNets() const {
+    return cyclic_nets_;
+  }
+
+  explicit Router(Instance, RouterOption = {});
 
  private:
+  /// @brief Times the phases of the router separately.
+  friend class RouterBenchmark;
+
   Instance instance_;
+  RouterOption option_;
+  /// @note Index 0 is not used.
+  std::vector<Interval> interval_of_nets_{};
   /// @note Is sorted by the start of the interval.
   std::vector<std::tuple<Interval, NetId>> horizontal_constraint_graph_{};
-  /// @note The index of the vector is the net id.
-  std::vector<std::vector<NetId>> vertical_constraint_graph_{};
+  /// @note The neighbors of each net are its parents, i.e., the nets that
+  /// are to be routed above it.
+  ConstraintGraph vertical_constraint_graph_{};
   /// @note Inverted VCG for routing in the bottom track.
-  std::vector<std::vector<NetId>> inverted_vertical_constraint_graph_{};
+  ConstraintGraph inverted_vertical_constraint_graph_{};
+  std::vector<NetId> cyclic_nets_{};
 
   const unsigned number_of_nets_;
   const unsigned number_of_pins_;
   unsigned number_of_routed_nets_ = 0u;
   std::vector<bool> routed_nets_;
+  /// @brief Where each net is routed, filled as the nets are routed and
+  /// moved into the result.
+  /// @note Index 0 is not used.
+  std::vector<RoutePlace> route_place_of_nets_;
+  /// @brief The nets on each extra track, keyed by the start of their
+  /// intervals, for `Reroute` to find the free places. Built from the result
+  /// by the first `Reroute` after `Route`.
+  /// @note Index 0 is not used, as the tracks are counted from 1.
+  std::vector<std::map<std::size_t, NetId>> channel_tracks_{};
 
   /// @brief Reset all the nets as not routed, so that the routing function can
   /// be called multiple time.
@@ -41,13 +102,31 @@ class Router {
 
   /// @note Routing in the top and bottom tracks are in fact the same, except
   /// that the bottom one uses the inverted VCG.
-  std::vector<std::vector<std::tuple<Interval, NetId>>> RouteInBoundaries_(
-      enum BoundaryKind);
+  void RouteInBoundaries_(enum BoundaryKind);
   /// @brief Routes all remaining nets in the extra tracks in the channel.
   /// @note Call this function after routing in the top and bottom tracks.
-  std::vector<std::vector<std::tuple<Interval, NetId>>> RouteInTracks_();
+  /// @return The number of the extra tracks.
+  std::size_t RouteInTracks_();
+
+  /// @note The VCG must be acyclic.
+  LowerBounds ComputeLowerBounds_() const;
+
+  void BuildChannelTracks_(const Result&);
+  /// @brief Removes the empty tracks from `channel_tracks_` and renumbers the
+  /// nets above them in `result`.
+  void RemoveEmptyTracks_(Result& result);
+  /// @return The parents and the children of the net, found from the pins in
+  /// its interval.
+  std::pair<NetIds, NetIds> FindParentsAndChildren_(NetId) const;
 };
 
+/// @brief Routes the channel in memory, with no file I/O, so that the router
+/// can be embedded in other tools.
+/// @note Reentrant; the channels can be routed on multiple threads at once.
+/// @return Nothing if the vertical constraints are cyclic.
+std::optional<Result> Route(const Instance& instance,
+                            RouterOption option = {});
+
 }  // namespace routing
 
 #endif  // ROUTING_ROUTER_H_
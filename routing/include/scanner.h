@@ -0,0 +1,41 @@
+#ifndef ROUTING_SCANNER_H_
+#define ROUTING_SCANNER_H_
+
+#include <iosfwd>
+
+#include "y.tab.hh"
+
+namespace routing {
+
+/// @brief A lexer of the channel routing instances.
+/// @details All the states of the scanning are kept in the object, so each
+/// parse owns its scanner and multiple instances can be scanned at once.
+class Scanner {
+ public:
+  /// @throw yy::parser::syntax_error on an invalid input.
+  yy::parser::symbol_type Lex();
+
+  /// @return The line of the last token, starting from 1.
+  int LineNo() const {
+    return line_no_;
+  }
+
+  explicit Scanner(std::istream& in);
+
+ private:
+  /// @note The characters are taken from the buffer directly, which is much
+  /// faster than through the stream for the large instances.
+  std::streambuf& in_;
+  int line_no_ = 1;
+  /// @brief Whether the last token is a newline, so the next one is on the
+  /// next line.
+  bool is_after_newline_ = false;
+
+  /// @brief Scans the number that starts with `first`, which is either 0 or
+  /// a positive number without leading zeros.
+  unsigned ScanNumber_(char first);
+};
+
+}  // namespace routing
+
+#endif  // ROUTING_SCANNER_H_
@@ -0,0 +1,65 @@
+#ifndef ROUTING_THREAD_POOL_H_
+#define ROUTING_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace routing {
+
+/// @brief A fixed number of workers that run the submitted tasks in FIFO
+/// order.
+class ThreadPool {
+ public:
+  /// @return The future of the result of `task`.
+  template <typename F>
+  std::future<std::invoke_result_t<F>> Submit(F&& task);
+
+  std::size_t Size() const {
+    return workers_.size();
+  }
+
+  /// @param number_of_threads 0 is treated as 1.
+  explicit ThreadPool(unsigned number_of_threads);
+  /// @note Blocks until all submitted tasks are done.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+ private:
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  bool stopping_ = false;
+
+  void Work_();
+};
+
+template <typename F>
+std::future<std::invoke_result_t<F>> ThreadPool::Submit(F&& task) {
+  // std::function requires the callable to be copyable, while the packaged
+  // task is move-only; share it instead.
+  auto packaged_task
+      = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(
+          std::forward<F>(task));
+  auto future = packaged_task->get_future();
+  {
+    auto lock = std::lock_guard{mutex_};
+    tasks_.emplace([packaged_task]() { (*packaged_task)(); });
+  }
+  task_available_.notify_one();
+  return future;
+}
+
+}  // namespace routing
+
+#endif  // ROUTING_THREAD_POOL_H_
@@ -1,42 +1,141 @@
 #include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iostream>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "arg.h"
 #include "instance.h"
 #include "output_formatter.h"
+#include "parse.h"
 #include "result.h"
 #include "router.h"
-#include "y.tab.hh"
+#include "thread_pool.h"
 
-#ifdef DEBUG
-#include <iostream>
-#endif
+using namespace routing;
 
-extern FILE* yyin;
-extern void yylex_destroy();
+namespace {
 
-using namespace routing;
+/// @return The instance in `file`, or nothing if it can't be read or
+/// parsed, with the errors reported to the standard error.
+std::optional<Instance> ParseInstance(const std::string& file) {
+  auto in = std::ifstream{file};
+  if (!in) {
+    std::perror(file.c_str());
+    return std::nullopt;
+  }
+  return Parse(in);
+}
 
-Instance instance;
+struct RoutedInstance {
+  /// @brief Nothing if the vertical constraints are cyclic.
+  std::optional<Result> result;
+  std::vector<NetId> cyclic_nets;
+};
 
-int main(int argc, char* argv[]) {
-  auto arg = HandleArguments(argc, argv);
-  auto in = fopen(arg.in.c_str(), "r");
-  if (!(yyin = in)) {
-    std::perror(argv[1]);
+RoutedInstance RouteInstance(Instance instance, RouterOption option) {
+  auto router = Router{std::move(instance), option};
+  auto result = router.Route();
+  if (!result) {
+    return {std::nullopt, router.CyclicNets()};
+  }
+  return {std::move(result), {}};
+}
+
+/// @note The result is streamed to the file in the order of the nets.
+void WriteResult(const std::filesystem::path& file, const Result& result,
+                 bool with_lower_bounds) {
+  auto out = std::ofstream{file};
+  auto output_formatter = OutputFormatter{out, result, with_lower_bounds};
+  output_formatter.Out();
+}
+
+void ReportCycle(const std::vector<NetId>& cyclic_nets) {
+  std::cerr << "The vertical constraints are cyclic, which can't be routed "
+               "without doglegs:";
+  for (auto net_id : cyclic_nets) {
+    std::cerr << ' ' << net_id;
+  }
+  std::cerr << '\n';
+}
+
+/// @brief Routes each instance listed in the manifest `arg.in` to
+/// `arg.out`/STEM.out. Each instance is parsed and routed on a worker, and
+/// the results are written in the order of the manifest.
+/// @return 0 if all the instances are routed, 1 otherwise.
+int RouteBatch(const Argument& arg, RouterOption option) {
+  auto manifest = std::ifstream{arg.in};
+  if (!manifest) {
+    std::perror(arg.in.c_str());
     return 1;
   }
-  yy::parser parser{};
-  int ret = parser.parse();
+  // The relative paths are relative to the manifest.
+  const auto base = std::filesystem::path{arg.in}.parent_path();
+  auto files = std::vector<std::filesystem::path>{};
+  for (auto line = std::string{}; std::getline(manifest, line);) {
+    if (!line.empty()) {
+      files.push_back(base / line);
+    }
+  }
+  const auto out_dir = std::filesystem::path{arg.out};
+  std::filesystem::create_directories(out_dir);
+
+  auto thread_pool = ThreadPool{
+      arg.threads ? arg.threads : std::thread::hardware_concurrency()};
+  auto routed = std::vector<std::future<std::optional<RoutedInstance>>>{};
+  routed.reserve(files.size());
+  for (const auto& file : files) {
+    routed.push_back(
+        thread_pool.Submit([&file, option]() -> std::optional<RoutedInstance> {
+          auto instance = ParseInstance(file);
+          if (!instance) {
+            return std::nullopt;
+          }
+          return RouteInstance(std::move(*instance), option);
+        }));
+  }
+
+  auto ret = 0;
+  for (auto i = std::size_t{0}; i < files.size(); i++) {
+    const auto routed_instance = routed.at(i).get();
+    if (!routed_instance) {
+      std::cerr << files.at(i).string() << ": failed to parse\n";
+      ret = 1;
+      continue;
+    }
+    if (!routed_instance->result) {
+      std::cerr << files.at(i).string() << ": ";
+      ReportCycle(routed_instance->cyclic_nets);
+      ret = 1;
+      continue;
+    }
+    auto name = files.at(i).stem();
+    name += ".out";
+    WriteResult(out_dir / name, *routed_instance->result, arg.lower_bounds);
+  }
+  return ret;
+}
 
-  yylex_destroy();
-  fclose(in);
+}  // namespace
 
-  // 0 on success, 1 otherwise
-  if (ret) {
-    return ret;
+int main(int argc, char* argv[]) {
+  auto arg = HandleArguments(argc, argv);
+  auto option = RouterOption{};
+  option.transitive_reduction = arg.transitive_reduction;
+  if (arg.batch) {
+    return RouteBatch(arg, option);
+  }
+
+  auto parsed = ParseInstance(arg.in);
+  if (!parsed) {
+    return 1;
   }
+  auto instance = std::move(*parsed);
 
 #ifdef DEBUG
   std::cerr << "TOP\n";
@@ -69,12 +168,12 @@ int main(int argc, char* argv[]) {
   std::cerr << '\n';
 #endif
 
-  auto router = Router{instance};
-  auto result = router.Route();
-
-  auto out = std::ofstream{arg.out};
-  auto output_formatter = OutputFormatter{out, result};
-  output_formatter.Out();
+  const auto routed_instance = RouteInstance(std::move(instance), option);
+  if (!routed_instance.result) {
+    ReportCycle(routed_instance.cyclic_nets);
+    return 1;
+  }
+  WriteResult(arg.out, *routed_instance.result, arg.lower_bounds);
 
   return 0;
 }
@@ -1,23 +1,43 @@
-%{
-#include <algorithm>
-#include <iostream>
-#include <string>
+/*
+ * A parser of the channel routing instances.
+ */
+
+// Dependency code required for the value and location types;
+// inserts verbatim to the header file.
+%code requires {
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "instance.h"
-#include "lex.yy.cc"
 
-extern Instance instance;
-%}
+using namespace routing;
 
-%code requires {
-  #include <array>
-  #include <tuple>
-  #include <utility>
-  #include <vector>
+namespace routing {
+
+class Scanner;
+
+/// @brief The states of a single parse. Nothing is shared across parses, so
+/// multiple instances can be parsed at once.
+struct ParseContext {
+  Instance instance;
+};
+
+}  // namespace routing
+}
+
+%code {
+#include <algorithm>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <string>
 
-  #include "instance.h"
+#include "parse.h"
+#include "scanner.h"
 
-  using namespace routing;
+static yy::parser::symbol_type yylex(routing::Scanner& scanner);
 }
 
 %skeleton "lalr1.cc"
@@ -39,6 +59,10 @@ extern Instance instance;
 // parser stack reductions before discovering the syntax error.
 %define parse.lac full
 
+// Pure parser; the states are passed instead of being global.
+%param {routing::Scanner& scanner}
+%parse-param {routing::ParseContext& parse_context}
+
 %token <int> TOP BOTTOM
 %token <unsigned> POS_NUMBER
 
@@ -58,12 +82,16 @@ instance:
   boundaries
   net_ids EOL
   net_ids EOF {
+    // The containers are moved rather than copied, so that building the
+    // instance is linear in the size of the input.
+    auto& instance = parse_context.instance;
     instance = Instance{
-      .top_boundaries = $1.at(BoundaryKind::kTop),
-      .bottom_boundaries = $1.at(BoundaryKind::kBottom),
-      .top_net_ids = $2,
-      .bottom_net_ids = $4,
+      .top_boundaries = std::move($1.at(BoundaryKind::kTop)),
+      .bottom_boundaries = std::move($1.at(BoundaryKind::kBottom)),
+      .top_net_ids = std::move($2),
+      .bottom_net_ids = std::move($4),
     };
+    // The intervals are appended in the order of the input and sorted once.
     for (auto& boundary : instance.top_boundaries) {
       std::sort(boundary.begin(), boundary.end());
     }
@@ -75,26 +103,19 @@ instance:
 
 boundaries:
   boundary {
-    auto boundaries = std::array<std::vector<std::vector<Interval>>, 2>{};
     auto [kind, dist, new_interval] = $1;
-    if (dist >= boundaries.at(kind).size()) {
-      boundaries.at(kind).resize(dist + 1);
-    }
-    // These nets goes to the same boundary, append them.
-    auto& boundary_with_dist = boundaries.at(kind).at(dist);
-    boundary_with_dist.push_back(new_interval);
-    $$ = boundaries;
+    $$.at(kind).resize(dist + 1);
+    $$.at(kind).at(dist).push_back(new_interval);
   }
   | boundaries boundary {
-    auto boundaries = $1;
+    // Take over the boundaries instead of copying them on every boundary.
+    $$ = std::move($1);
     auto [kind, dist, new_interval] = $2;
-    if (dist >= boundaries.at(kind).size()) {
-      boundaries.at(kind).resize(dist + 1);
+    if (dist >= $$.at(kind).size()) {
+      $$.at(kind).resize(dist + 1);
     }
     // These nets goes to the same boundary, append them.
-    auto& boundary_with_dist = boundaries.at(kind).at(dist);
-    boundary_with_dist.push_back(new_interval);
-    $$ = boundaries;
+    $$.at(kind).at(dist).push_back(new_interval);
   }
   ;
 
@@ -112,8 +133,9 @@ net_ids:
     $$ = NetIds{$1};
   }
   | net_ids POS_NUMBER {
-    $1.push_back($2);
-    $$ = $1;
+    // Take over the net ids instead of copying them on every pin.
+    $$ = std::move($1);
+    $$.push_back($2);
   }
   ;
 
@@ -126,6 +148,21 @@ interval:
 
 %%
 
+std::optional<Instance> routing::Parse(std::istream& in) {
+  auto scanner = Scanner{in};
+  auto context = ParseContext{};
+  auto parser = yy::parser{scanner, context};
+  // 0 on success, 1 otherwise
+  if (parser.parse()) {
+    return std::nullopt;
+  }
+  return std::move(context.instance);
+}
+
 void yy::parser::error(const std::string& err) {
-  std::cerr << err << std::endl;
+  std::cerr << "line " << scanner.LineNo() << ": " << err << std::endl;
+}
+
+static yy::parser::symbol_type yylex(routing::Scanner& scanner) {
+  return scanner.Lex();
 }
@@ -0,0 +1,164 @@
+#include "constraint_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "instance.h"
+
+using namespace routing;
+
+ConstraintGraph::ConstraintGraph(
+    unsigned number_of_nets,
+    const std::vector<std::pair<NetId, NetId>>& edges)
+    : offsets_(number_of_nets + 2 /* index 0 is not used, one past the end */),
+      neighbors_(edges.size()) {
+  // A counting sort of the edges by their nets.
+  for (const auto& [net_id, _] : edges) {
+    ++offsets_.at(net_id + 1);
+  }
+  for (auto net_id = std::size_t{1}; net_id < offsets_.size(); net_id++) {
+    offsets_.at(net_id) += offsets_.at(net_id - 1);
+  }
+  auto next = std::vector<std::size_t>(offsets_.begin(), offsets_.end() - 1);
+  for (const auto& [net_id, neighbor] : edges) {
+    neighbors_.at(next.at(net_id)++) = neighbor;
+  }
+
+  // Drop the duplicates in place. A neighbor is stamped with the net that
+  // last kept it, so each edge is checked in constant time.
+  auto stamp = std::vector<NetId>(number_of_nets + 1, kEmptySlot);
+  auto size = std::size_t{0};
+  for (auto net_id = NetId{1}; net_id <= number_of_nets; net_id++) {
+    const auto begin = offsets_.at(net_id);
+    const auto end = offsets_.at(net_id + 1);
+    offsets_.at(net_id) = size;
+    for (auto i = begin; i < end; i++) {
+      const auto neighbor = neighbors_.at(i);
+      if (stamp.at(neighbor) != net_id) {
+        stamp.at(neighbor) = net_id;
+        neighbors_.at(size++) = neighbor;
+      }
+    }
+  }
+  offsets_.back() = size;
+  neighbors_.resize(size);
+}
+
+ConstraintGraph ConstraintGraph::Inverted() const {
+  auto edges = std::vector<std::pair<NetId, NetId>>{};
+  edges.reserve(NumberOfEdges());
+  for (auto net_id = NetId{1}; net_id <= NumberOfNets_(); net_id++) {
+    for (auto neighbor : NeighborsOf(net_id)) {
+      edges.emplace_back(neighbor, net_id);
+    }
+  }
+  return ConstraintGraph{NumberOfNets_(), edges};
+}
+
+std::vector<NetId> ConstraintGraph::TopologicalOrder() const {
+  // Kahn's algorithm.
+  auto indegrees = std::vector<std::size_t>(NumberOfNets_() + 1);
+  for (auto neighbor : neighbors_) {
+    ++indegrees.at(neighbor);
+  }
+  auto order = std::vector<NetId>{};
+  order.reserve(NumberOfNets_());
+  for (auto net_id = NetId{1}; net_id <= NumberOfNets_(); net_id++) {
+    if (indegrees.at(net_id) == 0) {
+      order.push_back(net_id);
+    }
+  }
+  // The order itself is the queue.
+  for (auto i = std::size_t{0}; i < order.size(); i++) {
+    for (auto neighbor : NeighborsOf(order.at(i))) {
+      if (--indegrees.at(neighbor) == 0) {
+        order.push_back(neighbor);
+      }
+    }
+  }
+  return order;
+}
+
+std::vector<NetId> ConstraintGraph::FindCycle() const {
+  const auto order = TopologicalOrder();
+  if (order.size() == NumberOfNets_()) {
+    return {};
+  }
+  // Each net left out has a predecessor that is also left out, so walking
+  // back through them from any of them runs into a cycle.
+  auto is_ordered = std::vector<bool>(NumberOfNets_() + 1);
+  for (auto net_id : order) {
+    is_ordered.at(net_id) = true;
+  }
+  auto predecessors = std::vector<NetId>(NumberOfNets_() + 1, kEmptySlot);
+  for (auto net_id = NetId{1}; net_id <= NumberOfNets_(); net_id++) {
+    if (is_ordered.at(net_id)) {
+      continue;
+    }
+    for (auto neighbor : NeighborsOf(net_id)) {
+      predecessors.at(neighbor) = net_id;
+    }
+  }
+  auto net_id = NetId{1};
+  while (is_ordered.at(net_id)) {
+    ++net_id;
+  }
+  // The step at which each net is visited, 0 if not yet.
+  auto visited_at = std::vector<std::size_t>(NumberOfNets_() + 1);
+  for (auto step = std::size_t{1}; !visited_at.at(net_id); step++) {
+    visited_at.at(net_id) = step;
+    net_id = predecessors.at(net_id);
+  }
+  // The walk goes backward, so the cycle is reversed.
+  auto cycle = std::vector<NetId>{net_id};
+  for (auto prev = predecessors.at(net_id); prev != net_id;
+       prev = predecessors.at(prev)) {
+    cycle.push_back(prev);
+  }
+  std::reverse(cycle.begin(), cycle.end());
+  return cycle;
+}
+
+void ConstraintGraph::ReduceTransitively() {
+  const auto order = TopologicalOrder();
+  auto rank_of_nets = std::vector<std::size_t>(NumberOfNets_() + 1);
+  for (auto i = std::size_t{0}; i < order.size(); i++) {
+    rank_of_nets.at(order.at(i)) = i;
+  }
+  // The nets reachable from the net being reduced are stamped with it.
+  auto stamp = std::vector<NetId>(NumberOfNets_() + 1, kEmptySlot);
+  auto to_visit = std::vector<NetId>{};
+  auto size = std::size_t{0};
+  for (auto net_id = NetId{1}; net_id <= NumberOfNets_(); net_id++) {
+    const auto begin = neighbors_.begin() + offsets_.at(net_id);
+    const auto end = neighbors_.begin() + offsets_.at(net_id + 1);
+    offsets_.at(net_id) = size;
+    // A neighbor reachable through another one comes after it in the
+    // topological order, so the neighbors are visited in that order.
+    std::sort(begin, end, [&rank_of_nets](NetId lhs, NetId rhs) {
+      return rank_of_nets.at(lhs) < rank_of_nets.at(rhs);
+    });
+    for (auto it = begin; it != end; ++it) {
+      const auto neighbor = *it;
+      if (stamp.at(neighbor) == net_id) {
+        continue;
+      }
+      neighbors_.at(size++) = neighbor;
+      to_visit.push_back(neighbor);
+      while (!to_visit.empty()) {
+        const auto reached = to_visit.back();
+        to_visit.pop_back();
+        for (auto next : NeighborsOf(reached)) {
+          if (stamp.at(next) != net_id) {
+            stamp.at(next) = net_id;
+            to_visit.push_back(next);
+          }
+        }
+      }
+    }
+  }
+  offsets_.back() = size;
+  neighbors_.resize(size);
+}
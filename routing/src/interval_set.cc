@@ -0,0 +1,47 @@
+#include "interval_set.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "instance.h"
+#include "util.h"
+
+using namespace routing;
+
+void IntervalSet::Merge(const std::vector<Interval>& intervals) {
+  auto merged = std::vector<Interval>{};
+  merged.reserve(intervals_.size() + intervals.size());
+  // Take the interval that starts first from either side, and coalesce it
+  // into the last one if they overlap or are adjacent.
+  const auto Append = [&merged](const Interval& interval) {
+    if (!merged.empty() && interval.first <= merged.back().second) {
+      merged.back() = Union(merged.back(), interval);
+    } else {
+      merged.push_back(interval);
+    }
+  };
+  auto i = std::size_t{0};
+  auto j = std::size_t{0};
+  while (i < intervals_.size() || j < intervals.size()) {
+    if (j == intervals.size()
+        || (i < intervals_.size()
+            && intervals_.at(i).first < intervals.at(j).first)) {
+      Append(intervals_.at(i++));
+    } else {
+      Append(intervals.at(j++));
+    }
+  }
+  intervals_ = std::move(merged);
+}
+
+bool IntervalSet::Contains(const Interval& interval) const {
+  // Only the last interval that starts before `interval` may contain it, as
+  // the intervals of the set are disjoint.
+  const auto it = std::partition_point(
+      intervals_.begin(), intervals_.end(),
+      [&interval](const Interval& i) { return i.first < interval.first; });
+  return it != intervals_.begin() && IsContainedBy(interval, *std::prev(it));
+}
@@ -1,68 +1,79 @@
 #include "output_formatter.h"
 
 #include <cassert>
+#include <charconv>
+#include <cstddef>
 #include <ostream>
-#include <tuple>
-#include <unordered_map>
+#include <string>
 
 #include "instance.h"
 
 using namespace routing;
 
-enum class RoutePlaceKind { kTop, kTrack, kBottom };
+namespace {
+
+/// @brief The size of the blocks written to the stream.
+constexpr auto kBufferSize = std::size_t{1} << 20;
+
+void AppendNumber(std::string& buffer, std::size_t number) {
+  char digits[20];
+  const auto [end, _] = std::to_chars(digits, digits + sizeof(digits), number);
+  buffer.append(digits, end);
+}
+
+}  // namespace
 
 void OutputFormatter::Out() {
+  auto buffer = std::string{};
+  buffer.reserve(kBufferSize);
   // The number of extra tracks in the channel.
-  out_ << "Channel density: " << result_.tracks.size() << '\n';
-
-  // What we get from the result is the mapping from the track to the net, while
-  // we need the mapping from the net to the track for the output.
-  auto route_pos_of_nets = std::unordered_map<
-      NetId,
-      std::tuple<RoutePlaceKind, std::size_t /* track number */, Interval>>{};
-  for (auto i = std::size_t{0}, e = result_.top_tracks.size(); i < e; ++i) {
-    for (auto [interval, net_id] : result_.top_tracks.at(i)) {
-      route_pos_of_nets[net_id] = {RoutePlaceKind::kTop, i, interval};
-    }
-  }
-  for (auto i = std::size_t{0}, e = result_.tracks.size(); i < e; ++i) {
-    for (auto [interval, net_id] : result_.tracks.at(i)) {
-      // Although we route from the top to the bottom, the bottom most track
-      // is 1.
-      route_pos_of_nets[net_id] = {RoutePlaceKind::kTrack, e - i, interval};
-    }
-  }
-  for (auto i = std::size_t{0}, e = result_.bottom_tracks.size(); i < e; ++i) {
-    for (auto [interval, net_id] : result_.bottom_tracks.at(i)) {
-      route_pos_of_nets[net_id] = {RoutePlaceKind::kBottom, i, interval};
-    }
+  buffer += "Channel density: ";
+  AppendNumber(buffer, result_.number_of_tracks);
+  if (with_lower_bounds_) {
+    buffer += " (lower bounds: density ";
+    AppendNumber(buffer, result_.lower_bounds.density);
+    buffer += ", vertical constraints ";
+    AppendNumber(buffer, result_.lower_bounds.vertical_constraint);
+    buffer += ')';
   }
+  buffer += '\n';
 
   // Where each net is routed. In the order of the nets.
-  auto number_of_net = route_pos_of_nets.size();
-  for (auto i = 1u; i <= number_of_net; ++i) {
-    out_ << "Net " << i << '\n';
-    auto [route_type, track_number, interval] = route_pos_of_nets.at(i);
-    auto route_place_abbr = '\0';
+  const auto number_of_nets = result_.route_place_of_nets.size() - 1;
+  for (auto i = std::size_t{1}; i <= number_of_nets; ++i) {
+    const auto& [route_type, track_number, interval]
+        = result_.route_place_of_nets.at(i);
+    buffer += "Net ";
+    AppendNumber(buffer, i);
+    buffer += '\n';
     switch (route_type) {
       case RoutePlaceKind::kTop:
-        route_place_abbr = 'T';
+        buffer += 'T';
         break;
       case RoutePlaceKind::kTrack:
-        route_place_abbr = 'C';
+        buffer += 'C';
         break;
       case RoutePlaceKind::kBottom:
-        route_place_abbr = 'B';
+        buffer += 'B';
         break;
       default:
         assert(false && "Unknown kind of route place");
         break;
     }
-    out_ << route_place_abbr << track_number << ' ' << interval.first << ' '
-         << interval.second;
-    if (i != number_of_net) {
-      out_ << '\n';
+    AppendNumber(buffer, track_number);
+    buffer += ' ';
+    AppendNumber(buffer, interval.first);
+    buffer += ' ';
+    AppendNumber(buffer, interval.second);
+    if (i != number_of_nets) {
+      buffer += '\n';
       // No end-of-file newline.
     }
+    // A net takes less than a hundred characters.
+    if (buffer.size() + 100 > kBufferSize) {
+      out_.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
   }
+  out_.write(buffer.data(), buffer.size());
 }
@@ -2,9 +2,19 @@
 
 #include <algorithm>
 #include <cassert>
-#include <list>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
 
+#include "constraint_graph.h"
 #include "instance.h"
+#include "interval_set.h"
 #include "util.h"
 
 #ifdef DEBUG
@@ -13,8 +23,9 @@
 
 using namespace routing;
 
-Router::Router(Instance instance)
+Router::Router(Instance instance, RouterOption option)
     : instance_{std::move(instance)},
+      option_{option},
       number_of_nets_{
           // The id of the nets are guaranteed to be positive (0 is not a net
           // id) and
@@ -28,27 +39,385 @@ Router::Router(Instance instance)
   assert(instance_.top_net_ids.size() == instance_.bottom_net_ids.size());
 }
 
-Result Router::Route() {
+std::optional<Result> Router::Route() {
+  ResetRoutedNets_();
+  channel_tracks_.clear();
   ConstructHorizontalConstraintGraph_();
   ConstructVerticalConstraintGraph_();
+  // Report the cycles up front, as no track can take the nets on them.
+  cyclic_nets_ = vertical_constraint_graph_.FindCycle();
+  if (!cyclic_nets_.empty()) {
+    return std::nullopt;
+  }
+  if (option_.transitive_reduction) {
+    vertical_constraint_graph_.ReduceTransitively();
+    inverted_vertical_constraint_graph_
+        = vertical_constraint_graph_.Inverted();
+  }
 
-  auto top_tracks = RouteInBoundaries_(BoundaryKind::kTop);
-  auto bottom_tracks = RouteInBoundaries_(BoundaryKind::kBottom);
-  auto tracks = RouteInTracks_();
+  const auto lower_bounds = ComputeLowerBounds_();
+  route_place_of_nets_.assign(number_of_nets_ + 1 /* index 0 is not used */,
+                              RoutePlace{});
+  RouteInBoundaries_(BoundaryKind::kTop);
+  RouteInBoundaries_(BoundaryKind::kBottom);
+  const auto number_of_tracks = RouteInTracks_();
   return Result{
-      .top_tracks = top_tracks,
-      .tracks = tracks,
-      .bottom_tracks = bottom_tracks,
+      .number_of_tracks = number_of_tracks,
+      .lower_bounds = lower_bounds,
+      // Handed over instead of copied, as it's refilled on the next call.
+      .route_place_of_nets = std::move(route_place_of_nets_),
+  };
+}
+
+std::optional<Result> routing::Route(const Instance& instance,
+                                     RouterOption option) {
+  return Router{instance, option}.Route();
+}
+
+namespace {
+
+/// @return The height of the place, which is larger for the places above.
+/// @note Matches the order of the output: the top boundary, the extra tracks
+/// from the topmost one, and the bottom boundary.
+long HeightOf(const RoutePlace& route_place) {
+  // Above any extra track, however many are added.
+  constexpr auto kHeightOfTopBoundary = long{1} << 40;
+  switch (route_place.kind) {
+    case RoutePlaceKind::kTop:
+      return kHeightOfTopBoundary + route_place.track;
+    case RoutePlaceKind::kTrack:
+      return route_place.track;
+    case RoutePlaceKind::kBottom:
+    default:
+      return -static_cast<long>(route_place.track);
+  }
+}
+
+}  // namespace
+
+bool Router::Reroute(const std::vector<PinChange>& changes, Result& result) {
+  assert(!interval_of_nets_.empty() && "route before rerouting");
+  if (channel_tracks_.empty()) {
+    BuildChannelTracks_(result);
+  }
+
+  // The nets on the changed columns, before and after the changes, are the
+  // only ones whose intervals or constraints may change.
+  auto ripped_up_nets = NetIds{};
+  // To undo the changes if the nets turn out to be cyclic.
+  auto undo_changes = std::vector<PinChange>{};
+  for (const auto& [column, top_net_id, bottom_net_id] : changes) {
+    for (auto net_id :
+         {instance_.top_net_ids.at(column), instance_.bottom_net_ids.at(column),
+          top_net_id, bottom_net_id}) {
+      if (net_id != kEmptySlot) {
+        ripped_up_nets.push_back(net_id);
+      }
+    }
+    undo_changes.push_back({column, instance_.top_net_ids.at(column),
+                            instance_.bottom_net_ids.at(column)});
+    instance_.top_net_ids.at(column) = top_net_id;
+    instance_.bottom_net_ids.at(column) = bottom_net_id;
+  }
+  std::sort(ripped_up_nets.begin(), ripped_up_nets.end());
+  ripped_up_nets.erase(
+      std::unique(ripped_up_nets.begin(), ripped_up_nets.end()),
+      ripped_up_nets.end());
+  const auto number_of_tracks_before = result.number_of_tracks;
+  auto route_places_before = std::vector<RoutePlace>{};
+  auto intervals_before = std::vector<Interval>{};
+  for (auto net_id : ripped_up_nets) {
+    route_places_before.push_back(result.route_place_of_nets.at(net_id));
+    intervals_before.push_back(interval_of_nets_.at(net_id));
+  }
+  const auto RerouteFromScratch = [&]() {
+    auto rerouted = Route();
+    if (!rerouted) {
+      // Undo in reverse, in case a column is changed more than once. The
+      // tracks are built again from the result by the next `Reroute`.
+      for (auto it = undo_changes.rbegin(); it != undo_changes.rend(); ++it) {
+        instance_.top_net_ids.at(it->column) = it->top_net_id;
+        instance_.bottom_net_ids.at(it->column) = it->bottom_net_id;
+      }
+      result.number_of_tracks = number_of_tracks_before;
+      for (auto i = std::size_t{0}; i < ripped_up_nets.size(); i++) {
+        result.route_place_of_nets.at(ripped_up_nets.at(i))
+            = route_places_before.at(i);
+        interval_of_nets_.at(ripped_up_nets.at(i)) = intervals_before.at(i);
+      }
+      return false;
+    }
+    result = std::move(*rerouted);
+    return true;
+  };
+  const auto IsRippedUp = [&ripped_up_nets](NetId net_id) {
+    return std::binary_search(ripped_up_nets.begin(), ripped_up_nets.end(),
+                              net_id);
+  };
+  // The graphs are left to the next `Route` to construct again.
+  auto vacated_tracks = std::vector<std::size_t>{};
+  for (auto net_id : ripped_up_nets) {
+    const auto& route_place = result.route_place_of_nets.at(net_id);
+    if (route_place.kind == RoutePlaceKind::kTrack) {
+      channel_tracks_.at(route_place.track).erase(route_place.interval.first);
+      vacated_tracks.push_back(route_place.track);
+    }
+    // A net only loses pins in its interval, and gains them on the changed
+    // columns.
+    auto& interval = interval_of_nets_.at(net_id);
+    auto new_interval = Interval{number_of_pins_, 0};
+    const auto Extend = [&new_interval](std::size_t column) {
+      new_interval.first = std::min(new_interval.first, column);
+      new_interval.second = std::max(new_interval.second, column);
+    };
+    for (auto i = interval.first; i <= interval.second; i++) {
+      if (instance_.top_net_ids.at(i) == net_id
+          || instance_.bottom_net_ids.at(i) == net_id) {
+        Extend(i);
+      }
+    }
+    for (const auto& change : changes) {
+      if (instance_.top_net_ids.at(change.column) == net_id
+          || instance_.bottom_net_ids.at(change.column) == net_id) {
+        Extend(change.column);
+      }
+    }
+    assert(new_interval.first < number_of_pins_
+           && "the changes shall not remove all the pins of a net");
+    interval = new_interval;
+  }
+
+  // Pack the parents before their children, as each net is placed as high as
+  // possible to leave room for its children.
+  auto parents_and_children = std::vector<std::pair<NetIds, NetIds>>{};
+  parents_and_children.reserve(ripped_up_nets.size());
+  for (auto net_id : ripped_up_nets) {
+    parents_and_children.push_back(FindParentsAndChildren_(net_id));
+  }
+  const auto IndexOf = [&ripped_up_nets](NetId net_id) {
+    return static_cast<std::size_t>(
+        std::lower_bound(ripped_up_nets.begin(), ripped_up_nets.end(), net_id)
+        - ripped_up_nets.begin());
+  };
+  auto number_of_unpacked_parents
+      = std::vector<std::size_t>(ripped_up_nets.size());
+  auto order = std::vector<std::size_t>{};
+  for (auto i = std::size_t{0}; i < ripped_up_nets.size(); i++) {
+    for (auto parent : parents_and_children.at(i).first) {
+      if (IsRippedUp(parent)) {
+        ++number_of_unpacked_parents.at(i);
+      }
+    }
+    if (number_of_unpacked_parents.at(i) == 0) {
+      order.push_back(i);
+    }
+  }
+  for (auto i = std::size_t{0}; i < order.size(); i++) {
+    for (auto child : parents_and_children.at(order.at(i)).second) {
+      if (IsRippedUp(child)
+          && --number_of_unpacked_parents.at(IndexOf(child)) == 0) {
+        order.push_back(IndexOf(child));
+      }
+    }
+  }
+  if (order.size() != ripped_up_nets.size()) {
+    // A cycle among the changed nets.
+    return RerouteFromScratch();
+  }
+
+  for (auto i : order) {
+    const auto net_id = ripped_up_nets.at(i);
+    const auto& interval = interval_of_nets_.at(net_id);
+    const auto& [parents, children] = parents_and_children.at(i);
+    // Strictly between the lowest parent and the highest child. The children
+    // that are ripped up go under the net later.
+    auto highest = std::numeric_limits<long>::max();
+    for (auto parent : parents) {
+      highest = std::min(highest,
+                         HeightOf(result.route_place_of_nets.at(parent)) - 1);
+    }
+    auto lowest = std::numeric_limits<long>::min();
+    for (auto child : children) {
+      if (!IsRippedUp(child)) {
+        lowest = std::max(
+            lowest, HeightOf(result.route_place_of_nets.at(child)) + 1);
+      }
+    }
+    const auto IsFree = [this, &interval](std::size_t track) {
+      const auto& nets = channel_tracks_.at(track);
+      // The last net that starts before the end of the interval is the only
+      // one that may overlap it.
+      const auto it = nets.upper_bound(interval.second);
+      return it == nets.begin()
+             || interval_of_nets_.at(std::prev(it)->second).second
+                    < interval.first;
+    };
+    auto track = std::size_t{0};
+    for (auto t = std::min<long>(highest, result.number_of_tracks);
+         t >= std::max<long>(lowest, 1); t--) {
+      if (IsFree(static_cast<std::size_t>(t))) {
+        track = static_cast<std::size_t>(t);
+        break;
+      }
+    }
+    if (track == 0) {
+      if (highest <= static_cast<long>(result.number_of_tracks)
+          || lowest > static_cast<long>(result.number_of_tracks) + 1) {
+        // No room between the parents and the children.
+        return RerouteFromScratch();
+      }
+      track = ++result.number_of_tracks;
+      channel_tracks_.emplace_back();
+    }
+    channel_tracks_.at(track).emplace(interval.first, net_id);
+    result.route_place_of_nets.at(net_id)
+        = {RoutePlaceKind::kTrack, static_cast<unsigned>(track), interval};
+  }
+
+  if (std::any_of(vacated_tracks.begin(), vacated_tracks.end(),
+                  [this](std::size_t track) {
+                    return channel_tracks_.at(track).empty();
+                  })) {
+    RemoveEmptyTracks_(result);
+  }
+  return true;
+}
+
+void Router::RemoveEmptyTracks_(Result& result) {
+  // Moving the tracks above an empty one down keeps the nets in the same
+  // order from top to bottom, so the vertical constraints still hold.
+  auto number_of_tracks = std::size_t{0};
+  for (auto track = std::size_t{1}; track < channel_tracks_.size(); track++) {
+    if (channel_tracks_.at(track).empty()) {
+      continue;
+    }
+    if (++number_of_tracks != track) {
+      for (const auto& [_, net_id] : channel_tracks_.at(track)) {
+        result.route_place_of_nets.at(net_id).track
+            = static_cast<unsigned>(number_of_tracks);
+      }
+      channel_tracks_.at(number_of_tracks)
+          = std::move(channel_tracks_.at(track));
+    }
+  }
+  channel_tracks_.resize(number_of_tracks + 1 /* counted from 1 */);
+  result.number_of_tracks = number_of_tracks;
+}
+
+LowerBounds Router::ComputeLowerBounds_() const {
+  // The number of the nets that cross each column, as a difference array
+  // over the ends of their intervals. A boundary track can take one of them
+  // if the column is strictly inside its space, so each space of each
+  // distance takes one off the columns inside it.
+  auto difference = std::vector<long>(number_of_pins_ + 1);
+  for (auto net_id = NetId{1}; net_id <= number_of_nets_; net_id++) {
+    const auto& interval = interval_of_nets_.at(net_id);
+    ++difference.at(interval.first);
+    --difference.at(interval.second + 1);
+  }
+  // The nets that fit in any of the spaces of the top or the bottom.
+  auto fits_in_boundaries = std::vector<bool>(number_of_nets_ + 1);
+  for (const auto* boundaries :
+       {&instance_.top_boundaries, &instance_.bottom_boundaries}) {
+    auto rectilinear_boundaries = IntervalSet{};
+    for (auto dist = boundaries->size() - 1; dist > 0; dist--) {
+      rectilinear_boundaries.Merge(boundaries->at(dist));
+      for (const auto& [first, second] : rectilinear_boundaries.Intervals()) {
+        if (first + 1 < second) {
+          --difference.at(first + 1);
+          ++difference.at(second);
+        }
+      }
+    }
+    for (auto net_id = NetId{1}; net_id <= number_of_nets_; net_id++) {
+      if (rectilinear_boundaries.Contains(interval_of_nets_.at(net_id))) {
+        fits_in_boundaries.at(net_id) = true;
+      }
+    }
+  }
+  auto density = long{0};
+  auto crossing = long{0};
+  for (auto d : difference) {
+    crossing += d;
+    density = std::max(density, crossing);
+  }
+
+  // The longest chain, both of all the nets and of only those that don't fit
+  // in the boundaries. The boundary tracks take at most one net of a chain
+  // each, and none of the latter. The order has the children before their
+  // parents, which are the neighbors in the VCG.
+  auto chain = std::vector<std::size_t>(number_of_nets_ + 1, 1);
+  auto chain_in_tracks = std::vector<std::size_t>(number_of_nets_ + 1);
+  for (auto net_id = NetId{1}; net_id <= number_of_nets_; net_id++) {
+    chain_in_tracks.at(net_id) = fits_in_boundaries.at(net_id) ? 0 : 1;
+  }
+  auto longest_chain = std::size_t{0};
+  auto longest_chain_in_tracks = std::size_t{0};
+  for (auto net_id : vertical_constraint_graph_.TopologicalOrder()) {
+    longest_chain = std::max(longest_chain, chain.at(net_id));
+    longest_chain_in_tracks
+        = std::max(longest_chain_in_tracks, chain_in_tracks.at(net_id));
+    for (auto parent : vertical_constraint_graph_.NeighborsOf(net_id)) {
+      chain.at(parent) = std::max(chain.at(parent), chain.at(net_id) + 1);
+      chain_in_tracks.at(parent)
+          = std::max(chain_in_tracks.at(parent),
+                     chain_in_tracks.at(net_id)
+                         + (fits_in_boundaries.at(parent) ? 0 : 1));
+    }
+  }
+  const auto number_of_boundary_tracks = instance_.top_boundaries.size() - 1
+                                         + instance_.bottom_boundaries.size()
+                                         - 1;
+  return {
+      .density = static_cast<std::size_t>(density),
+      .vertical_constraint = std::max(
+          longest_chain_in_tracks,
+          longest_chain > number_of_boundary_tracks
+              ? longest_chain - number_of_boundary_tracks
+              : 0),
   };
 }
 
+void Router::BuildChannelTracks_(const Result& result) {
+  channel_tracks_.assign(result.number_of_tracks + 1 /* counted from 1 */, {});
+  for (auto net_id = NetId{1}; net_id <= number_of_nets_; net_id++) {
+    const auto& route_place = result.route_place_of_nets.at(net_id);
+    if (route_place.kind == RoutePlaceKind::kTrack) {
+      channel_tracks_.at(route_place.track)
+          .emplace(route_place.interval.first, net_id);
+    }
+  }
+}
+
+std::pair<NetIds, NetIds> Router::FindParentsAndChildren_(
+    NetId net_id) const {
+  // As in the VCG, the net on the top of a column is a parent of the one on
+  // the bottom.
+  auto parents = NetIds{};
+  auto children = NetIds{};
+  const auto& interval = interval_of_nets_.at(net_id);
+  for (auto i = interval.first; i <= interval.second; i++) {
+    const auto top_net_id = instance_.top_net_ids.at(i);
+    const auto bottom_net_id = instance_.bottom_net_ids.at(i);
+    if (top_net_id == kEmptySlot || bottom_net_id == kEmptySlot
+        || top_net_id == bottom_net_id) {
+      continue;
+    }
+    if (bottom_net_id == net_id) {
+      parents.push_back(top_net_id);
+    } else if (top_net_id == net_id) {
+      children.push_back(bottom_net_id);
+    }
+  }
+  return {std::move(parents), std::move(children)};
+}
+
 void Router::ResetRoutedNets_() {
   number_of_routed_nets_ = 0u;
   std::fill(routed_nets_.begin(), routed_nets_.end(), false);
 }
 
-std::vector<std::vector<std::tuple<Interval, NetId>>>
-Router::RouteInBoundaries_(enum BoundaryKind boundary_kind) {
+void Router::RouteInBoundaries_(enum BoundaryKind boundary_kind) {
   // Since we are not using doglegs, the rectilinear boundaries are only
   // beneficial for those nets that sit exactly in the interval of a distance of
   // boundary. Boundary of a distance may be multiple pieced, boundaries with
@@ -58,166 +427,206 @@ Router::RouteInBoundaries_(enum BoundaryKind boundary_kind) {
   // bottom boundaries in the same way as the top boundaries without violating
   // the constraint.
 
-  auto rectilinear_boundaries = std::list<Interval>{};
+  auto rectilinear_boundaries = IntervalSet{};
   /// @note These tracks aren't additional tracks. They use the space of the
-  /// boundary. The index is the distance from the innermost boundary.
-  auto tracks = std::vector<std::vector<std::tuple<Interval, NetId>>>(
-      boundary_kind == BoundaryKind::kTop
-          ? instance_.top_boundaries.size() - 1
-          : instance_.bottom_boundaries.size() - 1);
+  /// boundary. The track is the distance from the innermost boundary.
+  const auto number_of_tracks = boundary_kind == BoundaryKind::kTop
+                                    ? instance_.top_boundaries.size() - 1
+                                    : instance_.bottom_boundaries.size() - 1;
+  const auto route_place_kind = boundary_kind == BoundaryKind::kTop
+                                    ? RoutePlaceKind::kTop
+                                    : RoutePlaceKind::kBottom;
   const auto& vcg = boundary_kind == BoundaryKind::kTop
                         ? vertical_constraint_graph_
                         : inverted_vertical_constraint_graph_;
   const auto& boundaries = boundary_kind == BoundaryKind::kTop
                                ? instance_.top_boundaries
                                : instance_.bottom_boundaries;
+  // The nets not routed yet, sorted by the start of the interval as in the
+  // horizontal constraint graph.
+  auto candidates = std::vector<std::tuple<Interval, NetId>>{};
+  for (const auto& net : horizontal_constraint_graph_) {
+    if (!routed_nets_.at(std::get<1>(net))) {
+      candidates.push_back(net);
+    }
+  }
+  // The links to the next candidate that is not routed yet, as a disjoint-set
+  // forest: a routed candidate is linked to the one after it, and the links
+  // are halved as they're followed. So each net routed on a track is dropped
+  // once, instead of being skipped or erased on each of the later tracks.
+  auto next_unrouted = std::vector<std::size_t>(candidates.size() + 1);
+  std::iota(next_unrouted.begin(), next_unrouted.end(), std::size_t{0});
+  const auto NextUnrouted = [&next_unrouted](std::size_t i) {
+    while (next_unrouted.at(i) != i) {
+      next_unrouted.at(i) = next_unrouted.at(next_unrouted.at(i));
+      i = next_unrouted.at(i);
+    }
+    return i;
+  };
+  // @return The first candidate from `first` on that starts after `position`,
+  // whether it's routed or not.
+  const auto FirstAfter = [&candidates](std::size_t first,
+                                        std::size_t position) {
+    return static_cast<std::size_t>(
+        std::partition_point(candidates.begin() + first, candidates.end(),
+                             [position](const auto& candidate) {
+                               return std::get<0>(candidate).first
+                                      <= position;
+                             })
+        - candidates.begin());
+  };
 #ifdef DEBUG
   std::cerr << (boundary_kind == BoundaryKind::kTop ? "TOP" : "BOTTOM")
             << " TRACKS\n";
 #endif
-  for (auto dist = tracks.size(); dist > 0 /* 0 is the general case */;
+  for (auto dist = number_of_tracks; dist > 0 /* 0 is the general case */;
        dist--) {
-    // Since the intervals are sorted by the start of the interval, we can do an
-    // insertion sort along with the merge to make sure adjacent intervals are
-    // treated as one.
-    auto it = rectilinear_boundaries.begin();
-    for (const auto& interval : boundaries.at(dist)) {
-      while (true) {
-        if (it == rectilinear_boundaries.end()) {
-          rectilinear_boundaries.push_back(interval);
-          it = rectilinear_boundaries.begin();
-          break;
-        }
-        if (IsAdjacent(interval, *it)) {
-          *it = Union(interval, *it);
-          break;
-        }
-        if (interval.second < it->first) {
-          // Since we've checked the one before it, interval must be the one
-          // right before it.
-          rectilinear_boundaries.insert(it, interval);
-          break;
-        }
-        // The interval is after it. We need to find the exact place to insert
-        // it.
-        ++it;
-      }
-    }
+    // The boundaries of a distance are sorted by the start of the interval,
+    // so they are merged with the farther ones in a single pass, with the
+    // adjacent intervals treated as one.
+    rectilinear_boundaries.Merge(boundaries.at(dist));
 #ifdef DEBUG
     // Routed at dist - 1.
     std::cerr << (boundary_kind == BoundaryKind::kTop ? "Top" : "Bottom")
               << " intervals " << dist << '\t';
-    for (const auto& interval : rectilinear_boundaries) {
+    for (const auto& interval : rectilinear_boundaries.Intervals()) {
       std::cerr << "(" << interval.first << ", " << interval.second << ") ";
     }
     std::cerr << '\n';
 #endif
-    auto watermark = -1;
 #ifdef DEBUG
     std::cerr << (boundary_kind == BoundaryKind::kTop ? "TOP" : "BOTTOM")
               << " TRACK " << dist - 1 << '\n';
 #endif
-    for (const auto& [interval, net_id] : horizontal_constraint_graph_) {
-      if (routed_nets_.at(net_id)) {
-        continue;
-      }
-      for (const auto& boundary : rectilinear_boundaries) {
-        if (IsContainedBy(interval, boundary)) {
-          if (watermark == -1
-              || interval.first > static_cast<unsigned>(watermark)) {
-            auto all_parents_routed = true;
-            for (auto parent : vcg.at(net_id)) {
-              if (!routed_nets_.at(parent)) {
-                all_parents_routed = false;
+    // Sweep the spaces from left to right. The nets contained by a space
+    // start inside it, which are found by a binary search, so the nets
+    // outside of all the spaces are never visited.
+    auto i = std::size_t{0};
+    for (const auto& boundary : rectilinear_boundaries.Intervals()) {
+      for (i = NextUnrouted(FirstAfter(i, boundary.first));
+           i < candidates.size()
+           && std::get<0>(candidates.at(i)).first < boundary.second;
+           i = NextUnrouted(i + 1)) {
+        const auto& [interval, net_id] = candidates.at(i);
+        if (!IsContainedBy(interval, boundary)) {
+          continue;
+        }
+        auto all_parents_routed = true;
+        for (auto parent : vcg.NeighborsOf(net_id)) {
+          if (!routed_nets_.at(parent)) {
+            all_parents_routed = false;
 #ifdef DEBUG
-                std::cerr << "Net " << net_id << " has parent " << parent
-                          << " not routed\n";
+            std::cerr << "Net " << net_id << " has parent " << parent
+                      << " not routed\n";
 #endif
-                break;
-              }
-            }
-            if (all_parents_routed) {
-              routed_nets_.at(net_id) = true;
-              number_of_routed_nets_++;
-              watermark = interval.second;
-              tracks.at(dist - 1).emplace_back(interval, net_id);
-            }
+            break;
           }
         }
-      }
-    }
+        if (all_parents_routed) {
+          routed_nets_.at(net_id) = true;
+          number_of_routed_nets_++;
+          route_place_of_nets_.at(net_id) = {
+              route_place_kind, static_cast<unsigned>(dist - 1), interval};
 #ifdef DEBUG
-    for (const auto& [interval, net_id] : tracks.at(dist - 1)) {
-      std::cerr << "(" << interval.first << ", " << interval.second << ")\t"
-                << net_id << '\n';
-    }
+          std::cerr << "(" << interval.first << ", " << interval.second
+                    << ")\t" << net_id << '\n';
 #endif
+          next_unrouted.at(i) = i + 1;
+          // Those that start before the end of the net overlap it.
+          i = FirstAfter(i, interval.second) - 1;
+        }
+      }
+    }
   }
-  return tracks;
 }
 
-std::vector<std::vector<std::tuple<Interval, NetId>>> Router::RouteInTracks_() {
+std::size_t Router::RouteInTracks_() {
   // On each track in the channel, first set the watermark to -1, then select
-  // the net with the smallest* start of interval from the horizontal constraint
-  // graph:
-  // (1) if the net is not routed and the watermark is less than the start of
-  //     the interval:
-  //   (a) if all the parents of the net are routed, route the net and set the
-  //       watermark to the end of the interval.
-  //   (b) if not all the parents of the net are routed, skip the net.
-  // (2) if the net is not routed and the watermark is greater than or equal to
-  //     the start of the interval, skip the net.
-  // (3) if the net is routed, skip the net.
-  //  If there's not more nets that are possible to be routed in this track, go
-  //  to the next track.
-  // * From those nets that are not skipped.
+  // the net with the smallest start of interval from those that are ready,
+  // i.e., not routed with all their parents routed, and start after the
+  // watermark. Route the net and set the watermark to the end of its
+  // interval. If there's no more such nets, go to the next track.
+  // A net becomes ready when its last parent is routed, so the ready nets are
+  // kept ordered by their place in the horizontal constraint graph, and each
+  // net is found with a single successor query instead of rescanning the
+  // graph and the parents of each net.
+
+  // The number of the parents of each net that are not routed yet.
+  auto number_of_unrouted_parents
+      = std::vector<std::size_t>(number_of_nets_ + 1 /* index 0 is not used */);
+  // The place of each net in the horizontal constraint graph.
+  auto index_of_nets
+      = std::vector<std::size_t>(number_of_nets_ + 1 /* index 0 is not used */);
+  auto ready = std::set<std::size_t>{};
+  for (auto i = std::size_t{0}; i < horizontal_constraint_graph_.size(); i++) {
+    const auto net_id = std::get<1>(horizontal_constraint_graph_.at(i));
+    index_of_nets.at(net_id) = i;
+    if (routed_nets_.at(net_id)) {
+      continue;
+    }
+    for (auto parent : vertical_constraint_graph_.NeighborsOf(net_id)) {
+      if (!routed_nets_.at(parent)) {
+        ++number_of_unrouted_parents.at(net_id);
+      }
+    }
+    if (number_of_unrouted_parents.at(net_id) == 0) {
+      ready.insert(i);
+    }
+  }
+  // @return The place of the first net that starts after `watermark`.
+  const auto FirstAfter = [this](std::size_t watermark) {
+    return static_cast<std::size_t>(
+        std::partition_point(horizontal_constraint_graph_.begin(),
+                             horizontal_constraint_graph_.end(),
+                             [watermark](const auto& net) {
+                               return std::get<0>(net).first <= watermark;
+                             })
+        - horizontal_constraint_graph_.begin());
+  };
 
-  // On each track, several nets may be routed.
-  auto tracks = std::vector<std::vector<std::tuple<Interval, NetId>>>{};
+  // On each track, several nets may be routed. The tracks are counted from
+  // the top here.
+  auto number_of_tracks = std::size_t{0};
 #ifdef DEBUG
   std::cerr << "TRACKS\n";
 #endif
   while (number_of_routed_nets_ < number_of_nets_) {
-    assert(tracks.size() < number_of_nets_
+    assert(number_of_tracks < number_of_nets_
         && "the worst routing result shall not have to use more tracks than the number of nets");
-    tracks.emplace_back();
-    auto watermark = -1;
+    ++number_of_tracks;
 #ifdef DEBUG
-    std::cerr << "TRACK " << tracks.size() << '\n';
+    std::cerr << "TRACK " << number_of_tracks << '\n';
 #endif
-    for (const auto& [interval, net_id] : horizontal_constraint_graph_) {
-      if (routed_nets_.at(net_id)) {
-        continue;
-      }
-      if (watermark == -1
-          || interval.first > static_cast<unsigned>(watermark)) {
-        auto all_parents_routed = true;
-        for (auto parent : vertical_constraint_graph_.at(net_id)) {
-          if (!routed_nets_.at(parent)) {
-            all_parents_routed = false;
+    for (auto it = ready.begin(); it != ready.end();) {
+      const auto& [interval, net_id] = horizontal_constraint_graph_.at(*it);
+      ready.erase(it);
+      routed_nets_.at(net_id) = true;
+      number_of_routed_nets_++;
+      route_place_of_nets_.at(net_id) = {
+          RoutePlaceKind::kTrack, static_cast<unsigned>(number_of_tracks),
+          interval};
 #ifdef DEBUG
-            std::cerr << "Net " << net_id << " has parent " << parent
-                      << " not routed\n";
+      std::cerr << "(" << interval.first << ", " << interval.second << ")\t"
+                << net_id << '\n';
 #endif
-            break;
-          }
-        }
-        if (all_parents_routed) {
-          routed_nets_.at(net_id) = true;
-          number_of_routed_nets_++;
-          watermark = interval.second;
-          tracks.back().emplace_back(interval, net_id);
+      // The children are those under the net in the inverted graph.
+      for (auto child :
+           inverted_vertical_constraint_graph_.NeighborsOf(net_id)) {
+        if (!routed_nets_.at(child)
+            && --number_of_unrouted_parents.at(child) == 0) {
+          ready.insert(index_of_nets.at(child));
         }
       }
+      it = ready.lower_bound(FirstAfter(interval.second));
     }
-#ifdef DEBUG
-    for (const auto& [interval, net_id] : tracks.back()) {
-      std::cerr << "(" << interval.first << ", " << interval.second << ")\t"
-                << net_id << '\n';
+  }
+  // Although we route from the top to the bottom, the bottommost track is 1.
+  for (auto& [route_place_kind, track, _] : route_place_of_nets_) {
+    if (route_place_kind == RoutePlaceKind::kTrack) {
+      track = static_cast<unsigned>(number_of_tracks + 1 - track);
     }
-#endif
   }
-  return tracks;
+  return number_of_tracks;
 }
 
 void Router::ConstructHorizontalConstraintGraph_() {
@@ -225,19 +634,18 @@ void Router::ConstructHorizontalConstraintGraph_() {
   // the bottom. For each net id, find its smallest and largest index in the mix
   // top and bottom boundaries.
 
-  auto interval_of_nets
-      = std::vector<Interval>(number_of_nets_ + 1 /* index 0 is not used */,
-                              Interval{number_of_pins_ - 1, 0});
+  interval_of_nets_.assign(number_of_nets_ + 1 /* index 0 is not used */,
+                           Interval{number_of_pins_ - 1, 0});
   for (auto i = std::size_t{0}; i < number_of_pins_; i++) {
     {
       auto top_net_id = instance_.top_net_ids.at(i);
-      auto& interval = interval_of_nets.at(top_net_id);
+      auto& interval = interval_of_nets_.at(top_net_id);
       interval.first = std::min(interval.first, i);
       interval.second = std::max(interval.second, i);
     }
     {
       auto bottom_net_id = instance_.bottom_net_ids.at(i);
-      auto& interval = interval_of_nets.at(bottom_net_id);
+      auto& interval = interval_of_nets_.at(bottom_net_id);
       interval.first = std::min(interval.first, i);
       interval.second = std::max(interval.second, i);
     }
@@ -245,8 +653,9 @@ void Router::ConstructHorizontalConstraintGraph_() {
   // Sort the intervals by the start of the interval.
   // 0 is skipped. It's fine that we've take 0 into account in the previous
   // step.
+  horizontal_constraint_graph_.clear();
   for (auto net_id = 1u; net_id <= number_of_nets_; net_id++) {
-    horizontal_constraint_graph_.emplace_back(interval_of_nets.at(net_id),
+    horizontal_constraint_graph_.emplace_back(interval_of_nets_.at(net_id),
                                               net_id);
   }
   std::sort(horizontal_constraint_graph_.begin(),
@@ -266,12 +675,11 @@ void Router::ConstructHorizontalConstraintGraph_() {
 void Router::ConstructVerticalConstraintGraph_() {
   // For each net, we have a list keep its parents. Let n be the net at index i
   // of the bottom boundary, m be the net at index i of the top boundary. If n
-  // != m, then m is a parent of n.
+  // != m, then m is a parent of n. The duplicates, from the nets that face
+  // each other in several columns, are dropped as the graph is built.
 
-  vertical_constraint_graph_.resize(number_of_nets_
-                                    + 1 /* index 0 is not used */);
-  inverted_vertical_constraint_graph_.resize(number_of_nets_
-                                             + 1 /* index 0 is not used */);
+  auto edges = std::vector<std::pair<NetId, NetId>>{};
+  edges.reserve(number_of_pins_);
   for (auto i = std::size_t{0}; i < number_of_pins_; i++) {
     auto top_net_id = instance_.top_net_ids.at(i);
     auto bottom_net_id = instance_.bottom_net_ids.at(i);
@@ -279,37 +687,16 @@ void Router::ConstructVerticalConstraintGraph_() {
       continue;
     }
     if (top_net_id != bottom_net_id) {
-      // NOTE: This approach of avoiding duplicates may be inefficient, but the
-      // number of parents is small, so it should be fine.
-      auto in_list = false;
-      for (auto parent : vertical_constraint_graph_.at(bottom_net_id)) {
-        if (parent == top_net_id) {
-          in_list = true;
-          break;
-        }
-      }
-      if (!in_list) {
-        vertical_constraint_graph_.at(bottom_net_id).push_back(top_net_id);
-      }
-      // Add the inverted edge.
-      in_list = false;
-      for (auto parent : inverted_vertical_constraint_graph_.at(top_net_id)) {
-        if (parent == bottom_net_id) {
-          in_list = true;
-          break;
-        }
-      }
-      if (!in_list) {
-        inverted_vertical_constraint_graph_.at(top_net_id)
-            .push_back(bottom_net_id);
-      }
+      edges.emplace_back(bottom_net_id, top_net_id);
     }
   }
+  vertical_constraint_graph_ = ConstraintGraph{number_of_nets_, edges};
+  inverted_vertical_constraint_graph_ = vertical_constraint_graph_.Inverted();
 #ifdef DEBUG
   std::cerr << "VERTICAL CONSTRAINT GRAPH\n";
   for (auto net_id = 1u; net_id <= number_of_nets_; net_id++) {
     std::cerr << net_id << ": ";
-    for (auto parent : vertical_constraint_graph_.at(net_id)) {
+    for (auto parent : vertical_constraint_graph_.NeighborsOf(net_id)) {
       std::cerr << parent << " ";
     }
     std::cerr << '\n';
@@ -317,7 +704,8 @@ void Router::ConstructVerticalConstraintGraph_() {
   std::cerr << "INVERTED VERTICAL CONSTRAINT GRAPH\n";
   for (auto net_id = 1u; net_id <= number_of_nets_; net_id++) {
     std::cerr << net_id << ": ";
-    for (auto parent : inverted_vertical_constraint_graph_.at(net_id)) {
+    for (auto parent :
+         inverted_vertical_constraint_graph_.NeighborsOf(net_id)) {
       std::cerr << parent << " ";
     }
     std::cerr << '\n';
@@ -0,0 +1,64 @@
+#include "scanner.h"
+
+#include <istream>
+#include <streambuf>
+#include <string>
+
+#include "y.tab.hh"
+
+using namespace routing;
+
+namespace {
+
+bool IsDigit(int c) {
+  return c >= '0' && c <= '9';
+}
+
+}  // namespace
+
+Scanner::Scanner(std::istream& in) : in_{*in.rdbuf()} {}
+
+yy::parser::symbol_type Scanner::Lex() {
+  if (is_after_newline_) {
+    ++line_no_;
+    is_after_newline_ = false;
+  }
+  while (true) {
+    const auto c = in_.sbumpc();
+    if (c == std::streambuf::traits_type::eof()) {
+      return yy::parser::make_EOF();
+    }
+    if (c == ' ' || c == '\t' || c == '\r') {
+      continue;
+    }
+    if (c == '\n') {
+      is_after_newline_ = true;
+      return yy::parser::make_EOL();
+    }
+    /* keywords */
+    if ((c == 'T' || c == 'B') && IsDigit(in_.sgetc())) {
+      const auto dist
+          = static_cast<int>(ScanNumber_(static_cast<char>(in_.sbumpc())));
+      return c == 'T' ? yy::parser::make_TOP(dist)
+                      : yy::parser::make_BOTTOM(dist);
+    }
+    /* numbers */
+    if (IsDigit(c)) {
+      return yy::parser::make_POS_NUMBER(ScanNumber_(static_cast<char>(c)));
+    }
+    throw yy::parser::syntax_error{"Invalid input: "
+                                   + std::string(1, static_cast<char>(c))};
+  }
+}
+
+unsigned Scanner::ScanNumber_(char first) {
+  auto number = static_cast<unsigned>(first - '0');
+  // As a number doesn't have leading zeros, a 0 is a number of its own.
+  if (number == 0) {
+    return number;
+  }
+  while (IsDigit(in_.sgetc())) {
+    number = number * 10 + static_cast<unsigned>(in_.sbumpc() - '0');
+  }
+  return number;
+}
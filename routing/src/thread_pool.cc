@@ -0,0 +1,46 @@
+#include "thread_pool.h"
+
+#include <functional>
+#include <mutex>
+#include <utility>
+
+using namespace routing;
+
+ThreadPool::ThreadPool(unsigned number_of_threads) {
+  if (number_of_threads == 0) {
+    number_of_threads = 1;
+  }
+  workers_.reserve(number_of_threads);
+  for (auto i = 0u; i < number_of_threads; i++) {
+    workers_.emplace_back([this]() { Work_(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    auto lock = std::lock_guard{mutex_};
+    stopping_ = true;
+  }
+  task_available_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Work_() {
+  while (true) {
+    auto task = std::function<void()>{};
+    {
+      auto lock = std::unique_lock{mutex_};
+      task_available_.wait(lock,
+                           [this]() { return stopping_ || !tasks_.empty(); });
+      // Drain the remaining tasks before stopping.
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
@@ -0,0 +1,199 @@
+import argparse
+import random
+from typing import List, Optional
+
+
+class Channel:
+    def __init__(self, num_of_pins: int, num_of_nets: int, vcg_depth: int) -> None:
+        self.num_of_pins: int = num_of_pins
+        # 0 is an empty pin.
+        self.top: List[int] = [0] * num_of_pins
+        self.bottom: List[int] = [0] * num_of_pins
+        self.num_of_pins_of_nets: List[int] = [0] * (num_of_nets + 1)
+        # A net is only placed above those of a deeper level, so the
+        # vertical constraints are acyclic and the longest chain of them has
+        # at most `vcg_depth` nets.
+        self.levels: List[int] = [0] + [
+            random.randrange(vcg_depth) for _ in range(num_of_nets)
+        ]
+
+    def place(self, net: int, column: int) -> bool:
+        """
+        Places a pin of the net at the column, on the side that keeps the
+        levels in order. Returns false if neither side does.
+        """
+        top, bottom = self.top[column], self.bottom[column]
+        if top and bottom:
+            return False
+        if not top and not bottom:
+            is_top = random.random() < 0.5
+        elif top:
+            is_top = False
+            if top != net and self.levels[top] >= self.levels[net]:
+                return False
+        else:
+            is_top = True
+            if bottom != net and self.levels[net] >= self.levels[bottom]:
+                return False
+        (self.top if is_top else self.bottom)[column] = net
+        self.num_of_pins_of_nets[net] += 1
+        return True
+
+    def force(self, top: int, bottom: int, column: int) -> None:
+        """Places the nets at the column regardless of their levels."""
+        for nets, net in ((self.top, top), (self.bottom, bottom)):
+            self.num_of_pins_of_nets[nets[column]] -= 1
+            nets[column] = net
+            self.num_of_pins_of_nets[net] += 1
+
+
+def gen_boundaries(kind: str, num_of_pins: int, num_of_pieces: int, depth: int) -> List[str]:
+    """Cuts the channel into pieces, each at a random distance."""
+    num_of_pieces = min(num_of_pieces, num_of_pins - 1)
+    cuts: List[int] = sorted(random.sample(range(1, num_of_pins - 1), num_of_pieces - 1))
+    return [
+        f"{kind}{random.randint(0, depth)} {begin} {end}"
+        for begin, end in zip([0] + cuts, cuts + [num_of_pins - 1])
+    ]
+
+
+def gen(
+    num_of_pins: int,
+    num_of_nets: int,
+    vcg_depth: int,
+    density: int,
+    num_of_boundary_pieces: int,
+    boundary_depth: int,
+    is_cyclic: bool,
+) -> Optional[str]:
+    """
+    Each net spans `density * num_of_pins / num_of_nets` columns on average,
+    so `density` nets cross a column on average. The pins of a net are at both
+    ends of its span and a few columns in between. Returns None if the nets
+    don't fit in the pins.
+    """
+    channel = Channel(num_of_pins, num_of_nets, vcg_depth)
+    span: int = max(1, min(num_of_pins - 1, density * num_of_pins // num_of_nets))
+    for net in range(1, num_of_nets + 1):
+        length: int = random.randint(1, 2 * span - 1) if span > 1 else 1
+        length = min(length, num_of_pins - 1)
+        begin: int = random.randrange(num_of_pins - length)
+        columns: List[int] = [begin, begin + length]
+        columns += [random.randint(begin, begin + length) for _ in range(random.randint(0, 2))]
+        for column in columns:
+            channel.place(net, column)
+    if is_cyclic:
+        # Two nets above each other in two columns.
+        a, b = random.sample(range(1, num_of_nets + 1), k=2)
+        first, second = random.sample(range(num_of_pins), k=2)
+        channel.force(a, b, first)
+        channel.force(b, a, second)
+    # The net ids have to be consecutive, so the nets left without a pin take
+    # the empty columns.
+    empty_columns: List[int] = [
+        column
+        for column in range(num_of_pins)
+        if not channel.top[column] and not channel.bottom[column]
+    ]
+    random.shuffle(empty_columns)
+    for net in range(1, num_of_nets + 1):
+        if channel.num_of_pins_of_nets[net] == 0:
+            if not empty_columns:
+                return None
+            channel.place(net, empty_columns.pop())
+
+    lines: List[str] = gen_boundaries(
+        "T", num_of_pins, num_of_boundary_pieces, boundary_depth
+    ) + gen_boundaries("B", num_of_pins, num_of_boundary_pieces, boundary_depth)
+    # The top and the bottom boundaries may be interleaved.
+    random.shuffle(lines)
+    lines.append(" ".join(map(str, channel.top)))
+    lines.append(" ".join(map(str, channel.bottom)))
+    # The same as the sample instances, there's no end of file newline.
+    return "\n".join(lines)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter,
+        description="""
+Generates a channel routing instance to the file
+{num_of_nets}net-{num_of_pins}pin-{boundary_depth}t-{boundary_depth}b[-cyclic].in.
+The vertical constraints are acyclic unless --cyclic is given, which adds a
+cycle of two nets.
+The format is as the following:
+
+    ```
+    [<T|B><distance> <start> <end>]+
+    [<net id>]+
+    [<net id>]+
+    ```
+""",
+    )
+
+    def positive_int(value: str) -> int:
+        int_value = int(value)
+        if int_value <= 0:
+            raise argparse.ArgumentTypeError(f"{int_value} is not a positive int")
+        return int_value
+
+    def non_negative_int(value: str) -> int:
+        int_value = int(value)
+        if int_value < 0:
+            raise argparse.ArgumentTypeError(f"{int_value} is not a non-negative int")
+        return int_value
+
+    parser.add_argument("num_of_pins", type=positive_int)
+    parser.add_argument("num_of_nets", type=positive_int)
+    parser.add_argument(
+        "--vcg-depth",
+        type=positive_int,
+        default=8,
+        help="the maximum number of nets in a chain of vertical constraints (default: 8)",
+    )
+    parser.add_argument(
+        "--density",
+        type=positive_int,
+        default=8,
+        help="the average number of nets that cross a column (default: 8)",
+    )
+    parser.add_argument(
+        "--boundary-pieces",
+        type=positive_int,
+        default=8,
+        help="the number of pieces of each of the top and bottom boundaries (default: 8)",
+    )
+    parser.add_argument(
+        "--boundary-depth",
+        type=non_negative_int,
+        default=3,
+        help="the maximum distance of a boundary piece (default: 3)",
+    )
+    parser.add_argument(
+        "--cyclic",
+        action="store_true",
+        help="makes the vertical constraints cyclic",
+    )
+    parser.add_argument("--seed", type=int, help="the random seed")
+    args: argparse.Namespace = parser.parse_args()
+    if args.num_of_pins < 3:
+        parser.error("num_of_pins has to be at least 3")
+    random.seed(args.seed)
+    instance: Optional[str] = gen(
+        args.num_of_pins,
+        args.num_of_nets,
+        args.vcg_depth,
+        args.density,
+        args.boundary_pieces,
+        args.boundary_depth,
+        args.cyclic,
+    )
+    if instance is None:
+        parser.error("the nets don't fit in the pins")
+    name: str = (
+        f"{args.num_of_nets}net-{args.num_of_pins}pin"
+        f"-{args.boundary_depth}t-{args.boundary_depth}b"
+        f"{'-cyclic' if args.cyclic else ''}.in"
+    )
+    with open(name, mode="w+") as f:
+        f.write(instance)
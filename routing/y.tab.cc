@@ -1,8 +1,8 @@
-// A Bison parser, made by GNU Bison 3.5.1.
+// A Bison parser, made by GNU Bison 3.8.2.
 
 // Skeleton implementation for Bison LALR(1) parsers in C++
 
-// Copyright (C) 2002-2015, 2018-2020 Free Software Foundation, Inc.
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
 
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -15,7 +15,7 @@
 // GNU General Public License for more details.
 
 // You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 // As a special exception, you may create a larger work that contains
 // part or all of the Bison parser skeleton and distribute that work
@@ -30,29 +30,32 @@
 // This special exception was added by the Free Software Foundation in
 // version 2.2 of Bison.
 
-// Undocumented macros, especially those whose name start with YY_,
-// are private implementation details.  Do not rely on them.
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
 
 
 
-// First part of user prologue.
-#line 1 "parser.y"
 
-#include <algorithm>
-#include <iostream>
-#include <string>
 
-#include "instance.h"
-#include "lex.yy.cc"
+#include "y.tab.hh"
 
-extern Instance instance;
 
-#line 51 "y.tab.cc"
+// Unqualified %code blocks.
+#line 30 "parser.y"
 
+#include <algorithm>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <string>
 
-#include "y.tab.hh"
+#include "parse.h"
+#include "scanner.h"
 
+static yy::parser::symbol_type yylex(routing::Scanner& scanner);
 
+#line 59 "y.tab.cc"
 
 
 #ifndef YY_
@@ -67,6 +70,7 @@ extern Instance instance;
 # endif
 #endif
 
+
 // Whether we are compiled with exception support.
 #ifndef YY_EXCEPTIONS
 # if defined __GNUC__ && !defined __EXCEPTIONS
@@ -103,13 +107,13 @@ extern Instance instance;
 # define YY_STACK_PRINT()               \
   do {                                  \
     if (yydebug_)                       \
-      yystack_print_ ();                \
+      yy_stack_print_ ();                \
   } while (false)
 
 #else // !YYDEBUG
 
 # define YYCDEBUG if (false) std::cerr
-# define YY_SYMBOL_PRINT(Title, Symbol)  YYUSE (Symbol)
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
 # define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
 # define YY_STACK_PRINT()                static_cast<void> (0)
 
@@ -124,59 +128,19 @@ extern Instance instance;
 #define YYRECOVERING()  (!!yyerrstatus_)
 
 namespace yy {
-#line 128 "y.tab.cc"
-
-
-  /* Return YYSTR after stripping away unnecessary quotes and
-     backslashes, so that it's suitable for yyerror.  The heuristic is
-     that double-quoting is unnecessary unless the string contains an
-     apostrophe, a comma, or backslash (other than backslash-backslash).
-     YYSTR is taken from yytname.  */
-  std::string
-  parser::yytnamerr_ (const char *yystr)
-  {
-    if (*yystr == '"')
-      {
-        std::string yyr;
-        char const *yyp = yystr;
-
-        for (;;)
-          switch (*++yyp)
-            {
-            case '\'':
-            case ',':
-              goto do_not_strip_quotes;
-
-            case '\\':
-              if (*++yyp != '\\')
-                goto do_not_strip_quotes;
-              else
-                goto append;
-
-            append:
-            default:
-              yyr += *yyp;
-              break;
-
-            case '"':
-              return yyr;
-            }
-      do_not_strip_quotes: ;
-      }
-
-    return yystr;
-  }
-
+#line 132 "y.tab.cc"
 
   /// Build a parser object.
-  parser::parser ()
+  parser::parser (routing::Scanner& scanner_yyarg, routing::ParseContext& parse_context_yyarg)
 #if YYDEBUG
     : yydebug_ (false),
       yycdebug_ (&std::cerr),
 #else
     :
 #endif
-      yy_lac_established_ (false)
+      yy_lac_established_ (false),
+      scanner (scanner_yyarg),
+      parse_context (parse_context_yyarg)
   {}
 
   parser::~parser ()
@@ -185,9 +149,9 @@ namespace yy {
   parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
   {}
 
-  /*---------------.
-  | Symbol types.  |
-  `---------------*/
+  /*---------.
+  | symbol.  |
+  `---------*/
 
 
 
@@ -217,13 +181,13 @@ namespace yy {
     : state (s)
   {}
 
-  parser::symbol_number_type
-  parser::by_state::type_get () const YY_NOEXCEPT
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
   {
     if (state == empty_state)
-      return empty_symbol;
+      return symbol_kind::S_YYEMPTY;
     else
-      return yystos_[+state];
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
   }
 
   parser::stack_symbol_type::stack_symbol_type ()
@@ -232,30 +196,30 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
     : super_type (YY_MOVE (that.state))
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // interval
+      case symbol_kind::S_interval: // interval
         value.YY_MOVE_OR_COPY< Interval > (YY_MOVE (that.value));
         break;
 
-      case 12: // net_ids
+      case symbol_kind::S_net_ids: // net_ids
         value.YY_MOVE_OR_COPY< NetIds > (YY_MOVE (that.value));
         break;
 
-      case 3: // TOP
-      case 4: // BOTTOM
+      case symbol_kind::S_TOP: // TOP
+      case symbol_kind::S_BOTTOM: // BOTTOM
         value.YY_MOVE_OR_COPY< int > (YY_MOVE (that.value));
         break;
 
-      case 10: // boundaries
+      case symbol_kind::S_boundaries: // boundaries
         value.YY_MOVE_OR_COPY< std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > (YY_MOVE (that.value));
         break;
 
-      case 9: // boundary
+      case symbol_kind::S_boundary: // boundary
         value.YY_MOVE_OR_COPY< std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > (YY_MOVE (that.value));
         break;
 
-      case 5: // POS_NUMBER
+      case symbol_kind::S_POS_NUMBER: // POS_NUMBER
         value.YY_MOVE_OR_COPY< unsigned > (YY_MOVE (that.value));
         break;
 
@@ -272,30 +236,30 @@ namespace yy {
   parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
     : super_type (s)
   {
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // interval
+      case symbol_kind::S_interval: // interval
         value.move< Interval > (YY_MOVE (that.value));
         break;
 
-      case 12: // net_ids
+      case symbol_kind::S_net_ids: // net_ids
         value.move< NetIds > (YY_MOVE (that.value));
         break;
 
-      case 3: // TOP
-      case 4: // BOTTOM
+      case symbol_kind::S_TOP: // TOP
+      case symbol_kind::S_BOTTOM: // BOTTOM
         value.move< int > (YY_MOVE (that.value));
         break;
 
-      case 10: // boundaries
+      case symbol_kind::S_boundaries: // boundaries
         value.move< std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > (YY_MOVE (that.value));
         break;
 
-      case 9: // boundary
+      case symbol_kind::S_boundary: // boundary
         value.move< std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > (YY_MOVE (that.value));
         break;
 
-      case 5: // POS_NUMBER
+      case symbol_kind::S_POS_NUMBER: // POS_NUMBER
         value.move< unsigned > (YY_MOVE (that.value));
         break;
 
@@ -304,7 +268,7 @@ namespace yy {
     }
 
     // that is emptied.
-    that.type = empty_symbol;
+    that.kind_ = symbol_kind::S_YYEMPTY;
   }
 
 #if YY_CPLUSPLUS < 201103L
@@ -312,30 +276,30 @@ namespace yy {
   parser::stack_symbol_type::operator= (const stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // interval
+      case symbol_kind::S_interval: // interval
         value.copy< Interval > (that.value);
         break;
 
-      case 12: // net_ids
+      case symbol_kind::S_net_ids: // net_ids
         value.copy< NetIds > (that.value);
         break;
 
-      case 3: // TOP
-      case 4: // BOTTOM
+      case symbol_kind::S_TOP: // TOP
+      case symbol_kind::S_BOTTOM: // BOTTOM
         value.copy< int > (that.value);
         break;
 
-      case 10: // boundaries
+      case symbol_kind::S_boundaries: // boundaries
         value.copy< std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > (that.value);
         break;
 
-      case 9: // boundary
+      case symbol_kind::S_boundary: // boundary
         value.copy< std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > (that.value);
         break;
 
-      case 5: // POS_NUMBER
+      case symbol_kind::S_POS_NUMBER: // POS_NUMBER
         value.copy< unsigned > (that.value);
         break;
 
@@ -350,30 +314,30 @@ namespace yy {
   parser::stack_symbol_type::operator= (stack_symbol_type& that)
   {
     state = that.state;
-    switch (that.type_get ())
+    switch (that.kind ())
     {
-      case 11: // interval
+      case symbol_kind::S_interval: // interval
         value.move< Interval > (that.value);
         break;
 
-      case 12: // net_ids
+      case symbol_kind::S_net_ids: // net_ids
         value.move< NetIds > (that.value);
         break;
 
-      case 3: // TOP
-      case 4: // BOTTOM
+      case symbol_kind::S_TOP: // TOP
+      case symbol_kind::S_BOTTOM: // BOTTOM
         value.move< int > (that.value);
         break;
 
-      case 10: // boundaries
+      case symbol_kind::S_boundaries: // boundaries
         value.move< std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > (that.value);
         break;
 
-      case 9: // boundary
+      case symbol_kind::S_boundary: // boundary
         value.move< std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > (that.value);
         break;
 
-      case 5: // POS_NUMBER
+      case symbol_kind::S_POS_NUMBER: // POS_NUMBER
         value.move< unsigned > (that.value);
         break;
 
@@ -398,22 +362,20 @@ namespace yy {
 #if YYDEBUG
   template <typename Base>
   void
-  parser::yy_print_ (std::ostream& yyo,
-                                     const basic_symbol<Base>& yysym) const
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
   {
     std::ostream& yyoutput = yyo;
-    YYUSE (yyoutput);
-    symbol_number_type yytype = yysym.type_get ();
-#if defined __GNUC__ && ! defined __clang__ && ! defined __ICC && __GNUC__ * 100 + __GNUC_MINOR__ <= 408
-    // Avoid a (spurious) G++ 4.8 warning about "array subscript is
-    // below array bounds".
+    YY_USE (yyoutput);
     if (yysym.empty ())
-      std::abort ();
-#endif
-    yyo << (yytype < yyntokens_ ? "token" : "nterm")
-        << ' ' << yytname_[yytype] << " (";
-    YYUSE (yytype);
-    yyo << ')';
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " (";
+        YY_USE (yykind);
+        yyo << ')';
+      }
   }
 #endif
 
@@ -437,7 +399,7 @@ namespace yy {
   }
 
   void
-  parser::yypop_ (int n)
+  parser::yypop_ (int n) YY_NOEXCEPT
   {
     yystack_.pop (n);
   }
@@ -472,21 +434,21 @@ namespace yy {
   parser::state_type
   parser::yy_lr_goto_state_ (state_type yystate, int yysym)
   {
-    int yyr = yypgoto_[yysym - yyntokens_] + yystate;
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
     if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
       return yytable_[yyr];
     else
-      return yydefgoto_[yysym - yyntokens_];
+      return yydefgoto_[yysym - YYNTOKENS];
   }
 
   bool
-  parser::yy_pact_value_is_default_ (int yyvalue)
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yypact_ninf_;
   }
 
   bool
-  parser::yy_table_value_is_error_ (int yyvalue)
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
   {
     return yyvalue == yytable_ninf_;
   }
@@ -514,8 +476,8 @@ namespace yy {
     /// The return value of parse ().
     int yyresult;
 
-    /// Discard the LAC context in case there still is one left from a
-    /// previous invocation.
+    // Discard the LAC context in case there still is one left from a
+    // previous invocation.
     yy_lac_discard_ ("init");
 
 #if YY_EXCEPTIONS
@@ -537,6 +499,7 @@ namespace yy {
   `-----------------------------------------------*/
   yynewstate:
     YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
 
     // Accept?
     if (yystack_[0].state == yyfinal_)
@@ -557,12 +520,12 @@ namespace yy {
     // Read a lookahead token.
     if (yyla.empty ())
       {
-        YYCDEBUG << "Reading a token: ";
+        YYCDEBUG << "Reading a token\n";
 #if YY_EXCEPTIONS
         try
 #endif // YY_EXCEPTIONS
           {
-            symbol_type yylookahead (yylex ());
+            symbol_type yylookahead (yylex (scanner));
             yyla.move (yylookahead);
           }
 #if YY_EXCEPTIONS
@@ -576,13 +539,23 @@ namespace yy {
       }
     YY_SYMBOL_PRINT ("Next token is", yyla);
 
+    if (yyla.kind () == symbol_kind::S_YYerror)
+    {
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
+    }
+
     /* If the proper action on seeing token YYLA.TYPE is to reduce or
        to detect an error, take that action.  */
-    yyn += yyla.type_get ();
-    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.type_get ())
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
       {
-        if (!yy_lac_establish_ (yyla.type_get ()))
-           goto yyerrlab;
+        if (!yy_lac_establish_ (yyla.kind ()))
+          goto yyerrlab;
         goto yydefault;
       }
 
@@ -592,8 +565,8 @@ namespace yy {
       {
         if (yy_table_value_is_error_ (yyn))
           goto yyerrlab;
-        if (!yy_lac_establish_ (yyla.type_get ()))
-           goto yyerrlab;
+        if (!yy_lac_establish_ (yyla.kind ()))
+          goto yyerrlab;
 
         yyn = -yyn;
         goto yyreduce;
@@ -632,28 +605,28 @@ namespace yy {
          when using variants.  */
       switch (yyr1_[yyn])
     {
-      case 11: // interval
+      case symbol_kind::S_interval: // interval
         yylhs.value.emplace< Interval > ();
         break;
 
-      case 12: // net_ids
+      case symbol_kind::S_net_ids: // net_ids
         yylhs.value.emplace< NetIds > ();
         break;
 
-      case 3: // TOP
-      case 4: // BOTTOM
+      case symbol_kind::S_TOP: // TOP
+      case symbol_kind::S_BOTTOM: // BOTTOM
         yylhs.value.emplace< int > ();
         break;
 
-      case 10: // boundaries
+      case symbol_kind::S_boundaries: // boundaries
         yylhs.value.emplace< std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ();
         break;
 
-      case 9: // boundary
+      case symbol_kind::S_boundary: // boundary
         yylhs.value.emplace< std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > ();
         break;
 
-      case 5: // POS_NUMBER
+      case symbol_kind::S_POS_NUMBER: // POS_NUMBER
         yylhs.value.emplace< unsigned > ();
         break;
 
@@ -671,15 +644,19 @@ namespace yy {
         {
           switch (yyn)
             {
-  case 2:
-#line 60 "parser.y"
+  case 2: // instance: boundaries net_ids EOL net_ids EOF
+#line 84 "parser.y"
               {
+    // The containers are moved rather than copied, so that building the
+    // instance is linear in the size of the input.
+    auto& instance = parse_context.instance;
     instance = Instance{
-      .top_boundaries = yystack_[4].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(BoundaryKind::kTop),
-      .bottom_boundaries = yystack_[4].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(BoundaryKind::kBottom),
-      .top_net_ids = yystack_[3].value.as < NetIds > (),
-      .bottom_net_ids = yystack_[1].value.as < NetIds > (),
+      .top_boundaries = std::move(yystack_[4].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(BoundaryKind::kTop)),
+      .bottom_boundaries = std::move(yystack_[4].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(BoundaryKind::kBottom)),
+      .top_net_ids = std::move(yystack_[3].value.as < NetIds > ()),
+      .bottom_net_ids = std::move(yystack_[1].value.as < NetIds > ()),
     };
+    // The intervals are appended in the order of the input and sorted once.
     for (auto& boundary : instance.top_boundaries) {
       std::sort(boundary.begin(), boundary.end());
     }
@@ -687,84 +664,78 @@ namespace yy {
       std::sort(boundary.begin(), boundary.end());
     }
   }
-#line 691 "y.tab.cc"
+#line 668 "y.tab.cc"
     break;
 
-  case 3:
-#line 77 "parser.y"
+  case 3: // boundaries: boundary
+#line 105 "parser.y"
            {
-    auto boundaries = std::array<std::vector<std::vector<Interval>>, 2>{};
     auto [kind, dist, new_interval] = yystack_[0].value.as < std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > ();
-    if (dist >= boundaries.at(kind).size()) {
-      boundaries.at(kind).resize(dist + 1);
-    }
-    // These nets goes to the same boundary, append them.
-    auto& boundary_with_dist = boundaries.at(kind).at(dist);
-    boundary_with_dist.push_back(new_interval);
-    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > () = boundaries;
+    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(kind).resize(dist + 1);
+    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(kind).at(dist).push_back(new_interval);
   }
-#line 707 "y.tab.cc"
+#line 678 "y.tab.cc"
     break;
 
-  case 4:
-#line 88 "parser.y"
+  case 4: // boundaries: boundaries boundary
+#line 110 "parser.y"
                         {
-    auto boundaries = yystack_[1].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ();
+    // Take over the boundaries instead of copying them on every boundary.
+    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > () = std::move(yystack_[1].value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ());
     auto [kind, dist, new_interval] = yystack_[0].value.as < std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > ();
-    if (dist >= boundaries.at(kind).size()) {
-      boundaries.at(kind).resize(dist + 1);
+    if (dist >= yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(kind).size()) {
+      yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(kind).resize(dist + 1);
     }
     // These nets goes to the same boundary, append them.
-    auto& boundary_with_dist = boundaries.at(kind).at(dist);
-    boundary_with_dist.push_back(new_interval);
-    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > () = boundaries;
+    yylhs.value.as < std::array<std::vector<std::vector<Interval>>, 2 /* top, bottom */> > ().at(kind).at(dist).push_back(new_interval);
   }
-#line 723 "y.tab.cc"
+#line 693 "y.tab.cc"
     break;
 
-  case 5:
-#line 102 "parser.y"
+  case 5: // boundary: TOP interval EOL
+#line 123 "parser.y"
                    {
     yylhs.value.as < std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > () = std::make_tuple(BoundaryKind::kTop, yystack_[2].value.as < int > (), yystack_[1].value.as < Interval > ());
   }
-#line 731 "y.tab.cc"
+#line 701 "y.tab.cc"
     break;
 
-  case 6:
-#line 105 "parser.y"
+  case 6: // boundary: BOTTOM interval EOL
+#line 126 "parser.y"
                         {
     yylhs.value.as < std::tuple<BoundaryKind, unsigned /* the distance from the innermost boundary */, Interval> > () = std::make_tuple(BoundaryKind::kBottom, yystack_[2].value.as < int > (), yystack_[1].value.as < Interval > ());
   }
-#line 739 "y.tab.cc"
+#line 709 "y.tab.cc"
     break;
 
-  case 7:
-#line 111 "parser.y"
+  case 7: // net_ids: POS_NUMBER
+#line 132 "parser.y"
              {
     yylhs.value.as < NetIds > () = NetIds{yystack_[0].value.as < unsigned > ()};
   }
-#line 747 "y.tab.cc"
+#line 717 "y.tab.cc"
     break;
 
-  case 8:
-#line 114 "parser.y"
+  case 8: // net_ids: net_ids POS_NUMBER
+#line 135 "parser.y"
                        {
-    yystack_[1].value.as < NetIds > ().push_back(yystack_[0].value.as < unsigned > ());
-    yylhs.value.as < NetIds > () = yystack_[1].value.as < NetIds > ();
+    // Take over the net ids instead of copying them on every pin.
+    yylhs.value.as < NetIds > () = std::move(yystack_[1].value.as < NetIds > ());
+    yylhs.value.as < NetIds > ().push_back(yystack_[0].value.as < unsigned > ());
   }
-#line 756 "y.tab.cc"
+#line 727 "y.tab.cc"
     break;
 
-  case 9:
-#line 121 "parser.y"
+  case 9: // interval: POS_NUMBER POS_NUMBER
+#line 143 "parser.y"
                         {
     yylhs.value.as < Interval > () = Interval{yystack_[1].value.as < unsigned > (), yystack_[0].value.as < unsigned > ()};
   }
-#line 764 "y.tab.cc"
+#line 735 "y.tab.cc"
     break;
 
 
-#line 768 "y.tab.cc"
+#line 739 "y.tab.cc"
 
             default:
               break;
@@ -781,7 +752,6 @@ namespace yy {
       YY_SYMBOL_PRINT ("-> $$ =", yylhs);
       yypop_ (yylen);
       yylen = 0;
-      YY_STACK_PRINT ();
 
       // Shift the result of the reduction.
       yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
@@ -797,7 +767,9 @@ namespace yy {
     if (!yyerrstatus_)
       {
         ++yynerrs_;
-        error (yysyntax_error_ (yystack_[0].state, yyla));
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (YY_MOVE (msg));
       }
 
 
@@ -807,7 +779,7 @@ namespace yy {
            error, discard it.  */
 
         // Return failure if at end of input.
-        if (yyla.type_get () == yyeof_)
+        if (yyla.kind () == symbol_kind::S_YYEOF)
           YYABORT;
         else if (!yyla.empty ())
           {
@@ -833,6 +805,7 @@ namespace yy {
        this YYERROR.  */
     yypop_ (yylen);
     yylen = 0;
+    YY_STACK_PRINT ();
     goto yyerrlab1;
 
 
@@ -841,30 +814,32 @@ namespace yy {
   `-------------------------------------------------------------*/
   yyerrlab1:
     yyerrstatus_ = 3;   // Each real token shifted decrements this.
-    {
-      stack_symbol_type error_token;
-      for (;;)
-        {
-          yyn = yypact_[+yystack_[0].state];
-          if (!yy_pact_value_is_default_ (yyn))
-            {
-              yyn += yy_error_token_;
-              if (0 <= yyn && yyn <= yylast_ && yycheck_[yyn] == yy_error_token_)
-                {
-                  yyn = yytable_[yyn];
-                  if (0 < yyn)
-                    break;
-                }
-            }
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
+              {
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
+              }
+          }
 
-          // Pop the current state because it cannot handle the error token.
-          if (yystack_.size () == 1)
-            YYABORT;
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
 
-          yy_destroy_ ("Error: popping", yystack_[0]);
-          yypop_ ();
-          YY_STACK_PRINT ();
-        }
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
+      }
+    {
+      stack_symbol_type error_token;
 
 
       // Shift the error token.
@@ -901,6 +876,7 @@ namespace yy {
     /* Do not reclaim the symbols of the rule whose action triggered
        this YYABORT or YYACCEPT.  */
     yypop_ (yylen);
+    YY_STACK_PRINT ();
     while (1 < yystack_.size ())
       {
         yy_destroy_ ("Cleanup: popping", yystack_[0]);
@@ -934,15 +910,105 @@ namespace yy {
     error (yyexc.what ());
   }
 
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
+  std::string
+  parser::yytnamerr_ (const char *yystr)
+  {
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
+
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
+
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+#if YYDEBUG
+    // Execute LAC once. We don't care if it is successful, we
+    // only do it for the sake of debugging output.
+    if (!yyparser_.yy_lac_established_)
+      yyparser_.yy_lac_check_ (yyla_.kind ());
+#endif
+
+    for (int yyx = 0; yyx < YYNTOKENS; ++yyx)
+      {
+        symbol_kind_type yysym = YY_CAST (symbol_kind_type, yyx);
+        if (yysym != symbol_kind::S_YYerror
+            && yysym != symbol_kind::S_YYUNDEF
+            && yyparser_.yy_lac_check_ (yysym))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = yysym;
+          }
+      }
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
+
+
   bool
-  parser::yy_lac_check_ (int yytoken) const
+  parser::yy_lac_check_ (symbol_kind_type yytoken) const
   {
     // Logically, the yylac_stack's lifetime is confined to this function.
     // Clear it, to get rid of potential left-overs from previous call.
     yylac_stack_.clear ();
     // Reduce until we encounter a shift and thereby accept the token.
 #if YYDEBUG
-    YYCDEBUG << "LAC: checking lookahead " << yytname_[yytoken] << ':';
+    YYCDEBUG << "LAC: checking lookahead " << symbol_name (yytoken) << ':';
 #endif
     std::ptrdiff_t lac_top = 0;
     while (true)
@@ -1006,14 +1072,14 @@ namespace yy {
                      : yylac_stack_.back ());
         // Push the resulting state of the reduction.
         state_type state = yy_lr_goto_state_ (top_state, yyr1_[yyrule]);
-        YYCDEBUG << " G" << state;
+        YYCDEBUG << " G" << int (state);
         yylac_stack_.push_back (state);
       }
   }
 
   // Establish the initial context if no initial context currently exists.
   bool
-  parser::yy_lac_establish_ (int yytoken)
+  parser::yy_lac_establish_ (symbol_kind_type yytoken)
   {
     /* Establish the initial context for the current lookahead if no initial
        context is currently established.
@@ -1038,21 +1104,22 @@ namespace yy {
        follows.  If no initial context is currently established for the
        current lookahead, then check if that lookahead can eventually be
        shifted if syntactic actions continue from the current context.  */
-    if (!yy_lac_established_)
+    if (yy_lac_established_)
+      return true;
+    else
       {
 #if YYDEBUG
         YYCDEBUG << "LAC: initial context established for "
-                 << yytname_[yytoken] << '\n';
+                 << symbol_name (yytoken) << '\n';
 #endif
         yy_lac_established_ = true;
         return yy_lac_check_ (yytoken);
       }
-    return true;
   }
 
   // Discard any previous initial lookahead context.
   void
-  parser::yy_lac_discard_ (const char* evt)
+  parser::yy_lac_discard_ (const char* event)
   {
    /* Discard any previous initial lookahead context because of Event,
       which may be a lookahead change or an invalidation of the currently
@@ -1068,23 +1135,16 @@ namespace yy {
     if (yy_lac_established_)
       {
         YYCDEBUG << "LAC: initial context discarded due to "
-                 << evt << '\n';
+                 << event << '\n';
         yy_lac_established_ = false;
       }
   }
 
-  // Generate an error message.
-  std::string
-  parser::yysyntax_error_ (state_type yystate, const symbol_type& yyla) const
-  {
-    // Number of reported tokens (one for the "unexpected", one per
-    // "expected").
-    std::ptrdiff_t yycount = 0;
-    // Its maximum.
-    enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-    // Arguments of yyformat.
-    char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
 
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
     /* There are many possibilities here to consider:
        - If this state is a consistent state with a default action, then
          the only way this function was invoked is if the default action
@@ -1107,35 +1167,26 @@ namespace yy {
          initial context during error recovery, leaving behind the
          current lookahead.
     */
-    if (!yyla.empty ())
-      {
-        symbol_number_type yytoken = yyla.type_get ();
-        yyarg[yycount++] = yytname_[yytoken];
 
-#if YYDEBUG
-        // Execute LAC once. We don't care if it is succesful, we
-        // only do it for the sake of debugging output.
-        if (!yy_lac_established_)
-          yy_lac_check_ (yytoken);
-#endif
-
-        int yyn = yypact_[+yystate];
-        if (!yy_pact_value_is_default_ (yyn))
-          {
-            for (int yyx = 0; yyx < yyntokens_; ++yyx)
-              if (yyx != yy_error_token_ && yyx != yy_undef_token_
-                  && yy_lac_check_ (yyx))
-                {
-                  if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                    {
-                      yycount = 1;
-                      break;
-                    }
-                  else
-                    yyarg[yycount++] = yytname_[yyx];
-                }
-          }
+    if (!yyctx.lookahead ().empty ())
+      {
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
       }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
 
     char const* yyformat = YY_NULLPTR;
     switch (yycount)
@@ -1160,7 +1211,7 @@ namespace yy {
     for (char const* yyp = yyformat; *yyp; ++yyp)
       if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
         {
-          yyres += yytnamerr_ (yyarg[yyi++]);
+          yyres += symbol_name (yyarg[yyi++]);
           ++yyp;
         }
       else
@@ -1169,61 +1220,61 @@ namespace yy {
   }
 
 
-  const signed char parser::yypact_ninf_ = -4;
+  const signed char parser::yypact_ninf_ = -6;
 
   const signed char parser::yytable_ninf_ = -1;
 
   const signed char
   parser::yypact_[] =
   {
-       3,    -1,    -1,     8,    -4,    -2,     6,     7,     9,    -4,
-      -4,    -4,     4,    -4,    -4,    -4,    -4,    11,     0,    -4
+       3,    -1,    -1,     8,    -2,    -6,     6,     7,     9,    -6,
+      -6,    -6,     4,    -6,    -6,    -6,    -6,    11,     0,    -6
   };
 
   const signed char
   parser::yydefact_[] =
   {
-       0,     0,     0,     0,     3,     0,     0,     0,     0,     1,
+       0,     0,     0,     0,     0,     3,     0,     0,     0,     1,
        7,     4,     0,     9,     5,     6,     8,     0,     0,     2
   };
 
   const signed char
   parser::yypgoto_[] =
   {
-      -4,    -4,    12,    -4,    10,    -3
+      -6,    -6,    -6,    10,    -5,    15
   };
 
   const signed char
   parser::yydefgoto_[] =
   {
-      -1,     3,     4,     5,     7,    12
+       0,     3,     4,     5,    12,     7
   };
 
   const signed char
   parser::yytable_[] =
   {
       19,     1,     2,    10,     6,    16,     1,     2,     9,    16,
-      17,    13,     8,    14,    18,    15,    10,    11
+      17,    13,    18,    14,    11,    15,    10,     8
   };
 
   const signed char
   parser::yycheck_[] =
   {
        0,     3,     4,     5,     5,     5,     3,     4,     0,     5,
-       6,     5,     2,     6,    17,     6,     5,     5
+       6,     5,    17,     6,     4,     6,     5,     2
   };
 
   const signed char
   parser::yystos_[] =
   {
-       0,     3,     4,     8,     9,    10,     5,    11,    11,     0,
-       5,     9,    12,     5,     6,     6,     5,     6,    12,     0
+       0,     3,     4,     8,     9,    10,     5,    12,    12,     0,
+       5,    10,    11,     5,     6,     6,     5,     6,    11,     0
   };
 
   const signed char
   parser::yyr1_[] =
   {
-       0,     7,     8,    10,    10,     9,     9,    12,    12,    11
+       0,     7,     8,     9,     9,    10,    10,    11,    11,    12
   };
 
   const signed char
@@ -1233,26 +1284,28 @@ namespace yy {
   };
 
 
-
+#if YYDEBUG || 1
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-  // First, the terminals, then, starting at \a yyntokens_, nonterminals.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
   const char*
   const parser::yytname_[] =
   {
-  "EOF", "error", "$undefined", "TOP", "BOTTOM", "POS_NUMBER", "EOL",
-  "$accept", "instance", "boundary", "boundaries", "interval", "net_ids", YY_NULLPTR
+  "EOF", "error", "\"invalid token\"", "TOP", "BOTTOM", "POS_NUMBER",
+  "EOL", "$accept", "instance", "boundaries", "boundary", "net_ids",
+  "interval", YY_NULLPTR
   };
+#endif
+
 
 #if YYDEBUG
-  const signed char
+  const unsigned char
   parser::yyrline_[] =
   {
-       0,    58,    58,    77,    88,   102,   105,   111,   114,   121
+       0,    82,    82,   105,   110,   123,   126,   132,   135,   143
   };
 
-  // Print the state stack on the debug stream.
   void
-  parser::yystack_print_ ()
+  parser::yy_stack_print_ () const
   {
     *yycdebug_ << "Stack now";
     for (stack_type::const_iterator
@@ -1263,9 +1316,8 @@ namespace yy {
     *yycdebug_ << '\n';
   }
 
-  // Report on the debug stream that the rule \a yyrule is going to be reduced.
   void
-  parser::yy_reduce_print_ (int yyrule)
+  parser::yy_reduce_print_ (int yyrule) const
   {
     int yylno = yyrline_[yyrule];
     int yynrhs = yyr2_[yyrule];
@@ -1281,11 +1333,26 @@ namespace yy {
 
 
 } // yy
-#line 1285 "y.tab.cc"
+#line 1337 "y.tab.cc"
 
-#line 127 "parser.y"
+#line 149 "parser.y"
 
 
+std::optional<Instance> routing::Parse(std::istream& in) {
+  auto scanner = Scanner{in};
+  auto context = ParseContext{};
+  auto parser = yy::parser{scanner, context};
+  // 0 on success, 1 otherwise
+  if (parser.parse()) {
+    return std::nullopt;
+  }
+  return std::move(context.instance);
+}
+
 void yy::parser::error(const std::string& err) {
-  std::cerr << err << std::endl;
+  std::cerr << "line " << scanner.LineNo() << ": " << err << std::endl;
+}
+
+static yy::parser::symbol_type yylex(routing::Scanner& scanner) {
+  return scanner.Lex();
 }